@@ -57,6 +57,17 @@ class ScriptBitWriter
         WriteRaw(&value, 4); // 4 bytes = 32 bits
     }
     
+    /**
+     * @brief Write an integer value known to lie in a range, using only the bits the range needs
+     * @param value The value to write
+     * @param min The smallest possible value
+     * @param max The largest possible value
+     */
+    void WriteIntRange(int value, int min, int max)
+    {
+        WriteIntBits(value - min, GetRangeBits(min, max));
+    }
+    
     /**
      * @brief Write a string value
      * @param value The string to write
@@ -70,11 +81,29 @@ class ScriptBitWriter
         // Write each character as a 16-bit value
         for (int i = 0; i < length; i++)
         {
-            int charValue = value.GetChar(i);
+            int charValue = value.ToAscii(i);
             WriteIntBits(charValue, 16);
         }
     }
     
+    /**
+     * @brief Write a string compactly as its byte length followed by its UTF-8 bytes
+     * Used for chat text and names, which make up most of the chat traffic; read it with ReadUtf8String.
+     * @param value The string to write
+     */
+    void WriteUtf8String(string value)
+    {
+        // Write byte length first (up to 16 bits for length)
+        int length = value.Length();
+        WriteIntBits(length, 16);
+        
+        // Write each UTF-8 byte
+        for (int i = 0; i < length; i++)
+        {
+            WriteIntBits(value.ToAscii(i), 8);
+        }
+    }
+    
     /**
      * @brief Write raw binary data
      * @param data Pointer to the data
@@ -145,6 +174,25 @@ class ScriptBitWriter
         }
     }
     
+    /**
+     * @brief Get the number of bits needed to store any value of a range
+     * @param min The smallest possible value
+     * @param max The largest possible value
+     * @return The number of bits
+     */
+    static int GetRangeBits(int min, int max)
+    {
+        int span = max - min;
+        int bits = 0;
+        while (span > 0 && bits < 32)
+        {
+            span = span >> 1;
+            bits++;
+        }
+        
+        return bits;
+    }
+    
     /**
      * @brief Get the size of the written data in bytes
      * @return The size in bytes
@@ -173,6 +221,9 @@ class ScriptBitReader
     protected ref array<int> m_Buffer = new array<int>();
     protected int m_BitPosition = 0;
     
+    // One-character string per byte value, built once and shared by all readers
+    protected static ref array<string> s_Characters;
+    
     /**
      * @brief Constructor
      */
@@ -260,7 +311,18 @@ class ScriptBitReader
     }
     
     /**
-     * @brief Read a string value
+     * @brief Read an integer value written with WriteIntRange
+     * @param min The smallest possible value
+     * @param max The largest possible value
+     * @return The read value
+     */
+    int ReadIntRange(int min, int max)
+    {
+        return ReadIntBits(ScriptBitWriter.GetRangeBits(min, max)) + min;
+    }
+    
+    /**
+     * @brief Read a string value written with WriteString
      * @return The read string
      */
     string ReadString()
@@ -272,8 +334,26 @@ class ScriptBitReader
         string result = "";
         for (int i = 0; i < length; i++)
         {
-            int charValue = ReadIntBits(16);
-            result += charValue.ToString();
+            result += GetCharacter(ReadIntBits(16));
+        }
+        
+        return result;
+    }
+    
+    /**
+     * @brief Read a string written with WriteUtf8String
+     * @return The read string
+     */
+    string ReadUtf8String()
+    {
+        // Read byte length
+        int length = ReadIntBits(16);
+        
+        // Read each UTF-8 byte
+        string result = "";
+        for (int i = 0; i < length; i++)
+        {
+            result += GetCharacter(ReadIntBits(8));
         }
         
         return result;
@@ -342,6 +422,27 @@ class ScriptBitReader
         return result;
     }
     
+    /**
+     * @brief Get the one-character string of a byte value
+     * Script cannot build a string from a run of bytes in one call, so readers append one
+     * character per byte; the table only saves converting each byte to a new string first.
+     * @param code The byte value; higher bits are ignored
+     * @return The one-character string
+     */
+    protected static string GetCharacter(int code)
+    {
+        if (!s_Characters)
+        {
+            s_Characters = new array<string>();
+            for (int value = 0; value < 256; value++)
+            {
+                s_Characters.Insert(value.AsciiToString());
+            }
+        }
+        
+        return s_Characters[code & 0xFF];
+    }
+    
     /**
      * @brief Align the bit position to the next byte boundary
      */
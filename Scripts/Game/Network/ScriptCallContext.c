@@ -193,6 +193,24 @@ class ScriptCallContext
         m_Reader.Reset();
     }
     
+    /**
+     * @brief Get the writer for serializers that write into the context directly
+     * @return The bit writer
+     */
+    ScriptBitWriter GetWriter()
+    {
+        return m_Writer;
+    }
+    
+    /**
+     * @brief Get the reader for deserializers that read from the context directly
+     * @return The bit reader
+     */
+    ScriptBitReader GetReader()
+    {
+        return m_Reader;
+    }
+    
     /**
      * @brief Get the raw data buffer
      * @return Pointer to the data buffer
@@ -34,6 +34,33 @@ class HudIcon
     // Whether to show icon
     protected bool m_ShowIcon = true;
     
+    // Fixed world position, used when the icon has no entity target
+    protected vector m_WorldPosition;
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Set a fixed world position for this icon
+     * @param position The world position
+     */
+    void SetWorldPosition(vector position)
+    {
+        m_Entity = null;
+        m_WorldPosition = position;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Get the world position of the icon
+     * @return The entity target's origin, or the fixed position if there is no target
+     */
+    vector GetWorldPosition()
+    {
+        if (m_Entity)
+            return m_Entity.GetOrigin();
+            
+        return m_WorldPosition;
+    }
+    
     //------------------------------------------------------------------------------------------------
     /**
      * @brief Set the entity target for this icon
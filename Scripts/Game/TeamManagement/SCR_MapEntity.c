@@ -161,6 +161,12 @@ class MapMarkerComponent
     // The display name
     protected string m_DisplayName;
     
+    // Fixed world position, used when the marker has no entity target
+    protected vector m_WorldPosition;
+    
+    // Whether the marker is drawn
+    protected bool m_Visible = true;
+    
     //------------------------------------------------------------------------------------------------
     /**
      * @brief Set the entity target for this marker
@@ -171,6 +177,27 @@ class MapMarkerComponent
         m_Entity = entity;
     }
     
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Set a fixed world position for this marker
+     * @param position The world position
+     */
+    void SetWorldPosition(vector position)
+    {
+        m_Entity = null;
+        m_WorldPosition = position;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Set whether the marker is drawn
+     * @param visible True to show, false to hide
+     */
+    void SetVisible(bool visible)
+    {
+        m_Visible = visible;
+    }
+    
     //------------------------------------------------------------------------------------------------
     /**
      * @brief Set the icon from a resource
@@ -260,4 +287,27 @@ class MapMarkerComponent
     {
         return m_DisplayName;
     }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Get the world position of the marker
+     * @return The entity target's origin, or the fixed position if there is no target
+     */
+    vector GetWorldPosition()
+    {
+        if (m_Entity)
+            return m_Entity.GetOrigin();
+            
+        return m_WorldPosition;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Check if the marker is drawn
+     * @return True if visible
+     */
+    bool IsVisible()
+    {
+        return m_Visible;
+    }
 }
\ No newline at end of file
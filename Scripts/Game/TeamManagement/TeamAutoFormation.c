@@ -0,0 +1,634 @@
+/**
+ * @brief Server-side engine that places unteamed players into teams
+ *
+ * A formation run is started once (e.g. at round start) and then advanced a little on every
+ * world update, so even large player counts never stall a frame. Players are bucketed into a
+ * coarse proximity grid; friends are kept together first, then open slots in existing teams
+ * are filled with nearby players, and the remaining players are grouped into new teams.
+ * Before committing, every placement is checked again a few players at a time, since players
+ * may have left or joined a team on their own during the run; the final update only hands
+ * the checked results to the TeamManager bulk API.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+#include "../Core/IEntity.c"
+#include "../Core/Game.c"
+#include "TeamManager.c"
+
+enum ETeamAutoFormationPhase
+{
+    IDLE,
+    GATHER,
+    FRIENDS,
+    FILL_PARTIAL,
+    FORM,
+    CHECK_FILL,
+    CHECK_GROUPS,
+    COMMIT
+}
+
+class TeamAutoFormation
+{
+    // Work units (players visited or candidates scored) processed per update
+    protected static const int WORK_UNITS_PER_UPDATE = 128;
+
+    // Size of a proximity grid cell (meters)
+    protected static const float CELL_SIZE = 200.0;
+
+    // Maximum candidates scored when picking the nearest player for a group
+    protected static const int MAX_CANDIDATES = 32;
+
+    // Minimum size of a newly formed team
+    protected static const int MIN_NEW_TEAM_SIZE = 2;
+
+    // The team manager reference
+    protected TeamManager m_TeamManager;
+
+    // Current phase of the run
+    protected ETeamAutoFormationPhase m_Phase = ETeamAutoFormationPhase.IDLE;
+
+    // Cursor into the current phase's work list
+    protected int m_Cursor;
+
+    // Work units left in the current update
+    protected int m_Budget;
+
+    // Team size limit for the current run
+    protected int m_MaxTeamSize;
+
+    // Players snapshotted at the start of the run
+    protected ref array<EntityID> m_PlayerIDs = new array<EntityID>();
+
+    // Per pending player: handle, entity, position and the team they were placed in
+    protected ref array<int> m_PendingHandles = new array<int>();
+    protected ref array<EntityID> m_PendingEntities = new array<EntityID>();
+    protected ref array<float> m_PendingX = new array<float>();
+    protected ref array<float> m_PendingZ = new array<float>();
+    protected ref array<int> m_PendingTargets = new array<int>();
+
+    // Pending player index by handle
+    protected ref map<int, int> m_PendingIndex = new map<int, int>();
+
+    // Proximity grid: cell key to pending player indices
+    protected ref map<int, ref array<int>> m_Cells = new map<int, ref array<int>>();
+
+    // Existing teams with free space, their anchor position and remaining free space
+    protected ref array<int> m_OpenTeams = new array<int>();
+    protected ref array<float> m_OpenTeamX = new array<float>();
+    protected ref array<float> m_OpenTeamZ = new array<float>();
+    protected ref array<int> m_OpenTeamSpace = new array<int>();
+    protected ref map<int, int> m_OpenTeamIndex = new map<int, int>();
+
+    // New teams formed by this run, as indices into the pending arrays
+    protected ref array<ref array<int>> m_NewGroups = new array<ref array<int>>();
+
+    // Players whose neighborhood had no partner, grouped together at the end
+    protected ref array<int> m_Leftovers = new array<int>();
+
+    // Checked placements into existing teams (player entity ID to team ID) and the space each team has left
+    protected ref map<int, int> m_Assignments = new map<int, int>();
+    protected ref map<int, int> m_RemainingSpace = new map<int, int>();
+
+    // Checked new teams, by player entity ID
+    protected ref array<ref array<EntityID>> m_CheckedGroups = new array<ref array<EntityID>>();
+
+    // Friend lists by player handle, supplied by the game mode
+    protected ref map<int, ref array<int>> m_Friends = new map<int, ref array<int>>();
+
+    /**
+     * @brief Constructor
+     * @param teamManager The team manager to commit results to
+     */
+    void TeamAutoFormation(TeamManager teamManager)
+    {
+        m_TeamManager = teamManager;
+    }
+
+    /**
+     * @brief Start a formation run over all currently connected players
+     * @return True if the run was started, false if one is already running or this is not the server
+     */
+    bool Start()
+    {
+        if (IsRunning())
+            return false;
+
+        if (GetGame().IsMultiplayer() && !GetGame().IsServer())
+            return false;
+
+        Reset();
+        m_MaxTeamSize = TeamManagementSettings.Get().m_MaxTeamSize;
+        GetGame().GetWorld().GetPlayerManager().GetPlayerIDs(m_PlayerIDs);
+        EnterPhase(ETeamAutoFormationPhase.GATHER);
+
+        Print("TeamAutoFormation: Started for " + m_PlayerIDs.Count() + " players");
+        return true;
+    }
+
+    /**
+     * @brief Abort the current run without committing anything
+     */
+    void Cancel()
+    {
+        Reset();
+    }
+
+    /**
+     * @brief Check if a formation run is in progress
+     * @return True while running
+     */
+    bool IsRunning()
+    {
+        return m_Phase != ETeamAutoFormationPhase.IDLE;
+    }
+
+    /**
+     * @brief Set the friends of a player; friends are kept in the same team where possible
+     * @param playerHandle The player handle
+     * @param friendHandles Handles of the player's friends
+     */
+    void SetFriends(int playerHandle, array<int> friendHandles)
+    {
+        if (!friendHandles || friendHandles.Count() == 0)
+        {
+            m_Friends.Remove(playerHandle);
+            return;
+        }
+
+        array<int> friends = new array<int>();
+        friends.Copy(friendHandles);
+        m_Friends.Set(playerHandle, friends);
+    }
+
+    /**
+     * @brief Advance the current run by one update's worth of work
+     * Called from the world module every update.
+     */
+    void Update()
+    {
+        m_Budget = WORK_UNITS_PER_UPDATE;
+
+        while (m_Budget > 0 && IsRunning())
+        {
+            switch (m_Phase)
+            {
+                case ETeamAutoFormationPhase.GATHER:
+                    StepGather();
+                    break;
+                case ETeamAutoFormationPhase.FRIENDS:
+                    StepFriends();
+                    break;
+                case ETeamAutoFormationPhase.FILL_PARTIAL:
+                    StepFillPartial();
+                    break;
+                case ETeamAutoFormationPhase.FORM:
+                    StepForm();
+                    break;
+                case ETeamAutoFormationPhase.CHECK_FILL:
+                    StepCheckFill();
+                    break;
+                case ETeamAutoFormationPhase.CHECK_GROUPS:
+                    StepCheckGroup();
+                    break;
+                case ETeamAutoFormationPhase.COMMIT:
+                    Commit();
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief Snapshot one player: pending players go into the grid, teamed players anchor their team
+     */
+    protected void StepGather()
+    {
+        if (m_Cursor >= m_PlayerIDs.Count())
+        {
+            EnterPhase(ETeamAutoFormationPhase.FRIENDS);
+            return;
+        }
+
+        m_Budget--;
+        IEntity player = GetGame().GetWorld().FindEntityByID(m_PlayerIDs[m_Cursor]);
+        m_Cursor++;
+        if (!player)
+            return;
+
+        PlayerController pc = PlayerController.Cast(player.GetController());
+        if (!pc)
+            return;
+
+        int playerHandle = pc.GetPlayerId();
+        vector position = player.GetOrigin();
+        int teamID = m_TeamManager.GetPlayerTeamByHandle(playerHandle);
+
+        if (teamID > 0)
+        {
+            // The first member seen anchors the team's position
+            int space = m_MaxTeamSize - m_TeamManager.GetTeamMemberCount(teamID);
+            if (space > 0 && !m_OpenTeamIndex.Contains(teamID))
+            {
+                m_OpenTeamIndex.Set(teamID, m_OpenTeams.Count());
+                m_OpenTeams.Insert(teamID);
+                m_OpenTeamX.Insert(position[0]);
+                m_OpenTeamZ.Insert(position[2]);
+                m_OpenTeamSpace.Insert(space);
+            }
+            return;
+        }
+
+        int index = m_PendingHandles.Count();
+        int cell = GetCellKey(position[0], position[2]);
+        m_PendingIndex.Set(playerHandle, index);
+        m_PendingHandles.Insert(playerHandle);
+        m_PendingEntities.Insert(player.GetID());
+        m_PendingX.Insert(position[0]);
+        m_PendingZ.Insert(position[2]);
+        m_PendingTargets.Insert(0);
+
+        array<int> cellPlayers = m_Cells.Get(cell);
+        if (!cellPlayers)
+        {
+            cellPlayers = new array<int>();
+            m_Cells.Set(cell, cellPlayers);
+        }
+        cellPlayers.Insert(index);
+    }
+
+    /**
+     * @brief Place one pending player into an open team that already holds one of their friends
+     */
+    protected void StepFriends()
+    {
+        if (m_Cursor >= m_PendingHandles.Count())
+        {
+            EnterPhase(ETeamAutoFormationPhase.FILL_PARTIAL);
+            return;
+        }
+
+        int index = m_Cursor;
+        m_Cursor++;
+        m_Budget--;
+
+        array<int> friends = m_Friends.Get(m_PendingHandles[index]);
+        if (!friends)
+            return;
+
+        foreach (int friendHandle : friends)
+        {
+            m_Budget--;
+            int openTeam;
+            if (!m_OpenTeamIndex.Find(m_TeamManager.GetPlayerTeamByHandle(friendHandle), openTeam))
+                continue;
+
+            if (m_OpenTeamSpace[openTeam] <= 0)
+                continue;
+
+            PlaceInOpenTeam(index, openTeam);
+            return;
+        }
+    }
+
+    /**
+     * @brief Place the nearest pending player into the current existing team, or move on once it is full
+     */
+    protected void StepFillPartial()
+    {
+        if (m_Cursor >= m_OpenTeams.Count())
+        {
+            EnterPhase(ETeamAutoFormationPhase.FORM);
+            return;
+        }
+
+        int openTeam = m_Cursor;
+        if (m_OpenTeamSpace[openTeam] > 0)
+        {
+            int nearest = FindNearestPending(m_OpenTeamX[openTeam], m_OpenTeamZ[openTeam]);
+            if (nearest != -1)
+            {
+                PlaceInOpenTeam(nearest, openTeam);
+                return;
+            }
+        }
+        else
+        {
+            m_Budget--;
+        }
+
+        // Full, or nobody left nearby
+        m_Cursor++;
+    }
+
+    /**
+     * @brief Form one new team around the next unplaced player
+     */
+    protected void StepForm()
+    {
+        if (m_Cursor >= m_PendingHandles.Count())
+        {
+            GroupLeftovers();
+            EnterPhase(ETeamAutoFormationPhase.CHECK_FILL);
+            return;
+        }
+
+        int seed = m_Cursor;
+        m_Cursor++;
+        m_Budget--;
+        if (m_PendingTargets[seed] != 0)
+            return;
+
+        array<int> group = new array<int>();
+        AddToGroup(group, seed);
+
+        // Friends first, wherever they are
+        array<int> friends = m_Friends.Get(m_PendingHandles[seed]);
+        if (friends)
+        {
+            foreach (int friendHandle : friends)
+            {
+                if (group.Count() >= m_MaxTeamSize)
+                    break;
+
+                m_Budget--;
+                int friendIndex;
+                if (m_PendingIndex.Find(friendHandle, friendIndex) && m_PendingTargets[friendIndex] == 0)
+                    AddToGroup(group, friendIndex);
+            }
+        }
+
+        // Then the nearest players around the seed
+        while (group.Count() < m_MaxTeamSize)
+        {
+            int nearest = FindNearestPending(m_PendingX[seed], m_PendingZ[seed]);
+            if (nearest == -1)
+                break;
+
+            AddToGroup(group, nearest);
+        }
+
+        if (group.Count() >= MIN_NEW_TEAM_SIZE)
+        {
+            m_NewGroups.Insert(group);
+            return;
+        }
+
+        // Nobody nearby; release the seed and group it with other isolated players later
+        m_PendingTargets[seed] = 0;
+        m_Leftovers.Insert(seed);
+    }
+
+    /**
+     * @brief Group isolated players together so they do not stay solo
+     */
+    protected void GroupLeftovers()
+    {
+        array<int> group;
+        foreach (int index : m_Leftovers)
+        {
+            if (m_PendingTargets[index] != 0)
+                continue;
+
+            if (!group || group.Count() >= m_MaxTeamSize)
+            {
+                group = new array<int>();
+                m_NewGroups.Insert(group);
+            }
+
+            AddToGroup(group, index);
+        }
+
+        // A single isolated player stays unteamed
+        if (group && group.Count() < MIN_NEW_TEAM_SIZE)
+        {
+            m_PendingTargets[group[0]] = 0;
+            m_NewGroups.RemoveItem(group);
+        }
+    }
+
+    /**
+     * @brief Check one player placed into an existing team, trimming to the space the team still has now
+     * Players that left or joined a team on their own during the run are skipped.
+     */
+    protected void StepCheckFill()
+    {
+        if (m_Cursor >= m_PendingHandles.Count())
+        {
+            EnterPhase(ETeamAutoFormationPhase.CHECK_GROUPS);
+            return;
+        }
+
+        int index = m_Cursor;
+        m_Cursor++;
+        m_Budget--;
+
+        int teamID = m_PendingTargets[index];
+        if (teamID <= 0 || !IsStillPending(index))
+            return;
+
+        int space;
+        if (!m_RemainingSpace.Find(teamID, space))
+            space = m_MaxTeamSize - m_TeamManager.GetTeamMemberCount(teamID);
+
+        if (space <= 0 || !m_TeamManager.TeamExists(teamID))
+            return;
+
+        m_Assignments.Set(m_PendingEntities[index].GetValue(), teamID);
+        m_RemainingSpace.Set(teamID, space - 1);
+    }
+
+    /**
+     * @brief Check the members of one new team; the seed of each group becomes its leader
+     */
+    protected void StepCheckGroup()
+    {
+        if (m_Cursor >= m_NewGroups.Count())
+        {
+            EnterPhase(ETeamAutoFormationPhase.COMMIT);
+            return;
+        }
+
+        array<int> group = m_NewGroups[m_Cursor];
+        m_Cursor++;
+
+        array<EntityID> members = new array<EntityID>();
+        foreach (int index : group)
+        {
+            m_Budget--;
+            if (IsStillPending(index))
+                members.Insert(m_PendingEntities[index]);
+        }
+
+        if (members.Count() >= MIN_NEW_TEAM_SIZE)
+            m_CheckedGroups.Insert(members);
+    }
+
+    /**
+     * @brief Commit the checked placements through the TeamManager bulk API
+     * The bulk calls validate again, so a player who changed team since their check fails that call.
+     */
+    protected void Commit()
+    {
+        m_Budget = 0;
+
+        if (m_Assignments.Count() > 0 && !m_TeamManager.AssignPlayers(m_Assignments))
+            Print("TeamAutoFormation: Filling existing teams failed validation");
+
+        array<int> teamIDs;
+        if (m_CheckedGroups.Count() > 0 && !m_TeamManager.CreateTeams(m_CheckedGroups, teamIDs))
+            Print("TeamAutoFormation: Creating new teams failed validation");
+
+        Print("TeamAutoFormation: Placed " + m_Assignments.Count() + " players into existing teams and formed " + m_CheckedGroups.Count() + " new teams");
+        Reset();
+    }
+
+    /**
+     * @brief Find the nearest unplaced pending player in the 3x3 cells around a position
+     * @param x World X coordinate
+     * @param z World Z coordinate
+     * @return The pending player index, or -1 if none is nearby
+     */
+    protected int FindNearestPending(float x, float z)
+    {
+        int cellX = Math.Floor(x / CELL_SIZE);
+        int cellZ = Math.Floor(z / CELL_SIZE);
+        int nearest = -1;
+        float nearestDistance;
+        int scanned = 0;
+
+        for (int dx = -1; dx <= 1; dx++)
+        {
+            for (int dz = -1; dz <= 1; dz++)
+            {
+                array<int> cellPlayers = m_Cells.Get(MakeCellKey(cellX + dx, cellZ + dz));
+                if (!cellPlayers)
+                    continue;
+
+                for (int c = cellPlayers.Count() - 1; c >= 0; c--)
+                {
+                    int index = cellPlayers[c];
+                    if (m_PendingTargets[index] != 0)
+                    {
+                        // Drop placed players so later searches skip them
+                        cellPlayers.Remove(c);
+                        continue;
+                    }
+
+                    float offsetX = m_PendingX[index] - x;
+                    float offsetZ = m_PendingZ[index] - z;
+                    float distance = offsetX * offsetX + offsetZ * offsetZ;
+                    if (nearest == -1 || distance < nearestDistance)
+                    {
+                        nearest = index;
+                        nearestDistance = distance;
+                    }
+
+                    scanned++;
+                    if (scanned >= MAX_CANDIDATES)
+                    {
+                        m_Budget -= scanned;
+                        return nearest;
+                    }
+                }
+            }
+        }
+
+        m_Budget -= scanned + 1;
+        return nearest;
+    }
+
+    /**
+     * @brief Place a pending player into an existing team
+     * @param index The pending player index
+     * @param openTeam Index into the open team arrays
+     */
+    protected void PlaceInOpenTeam(int index, int openTeam)
+    {
+        m_PendingTargets[index] = m_OpenTeams[openTeam];
+        m_OpenTeamSpace[openTeam] = m_OpenTeamSpace[openTeam] - 1;
+    }
+
+    /**
+     * @brief Add a pending player to a new team group
+     * New groups are marked with -1 until they get a real team ID at commit.
+     * @param group The group
+     * @param index The pending player index
+     */
+    protected void AddToGroup(array<int> group, int index)
+    {
+        m_PendingTargets[index] = -1;
+        group.Insert(index);
+    }
+
+    /**
+     * @brief Check that a snapshotted player is still connected and still unteamed
+     * @param index The pending player index
+     * @return True if the player can still be placed
+     */
+    protected bool IsStillPending(int index)
+    {
+        if (!GetGame().GetWorld().FindEntityByID(m_PendingEntities[index]))
+            return false;
+
+        return m_TeamManager.GetPlayerTeamByHandle(m_PendingHandles[index]) <= 0;
+    }
+
+    /**
+     * @brief Switch to a phase and reset its cursor
+     * @param phase The phase to enter
+     */
+    protected void EnterPhase(ETeamAutoFormationPhase phase)
+    {
+        m_Phase = phase;
+        m_Cursor = 0;
+    }
+
+    /**
+     * @brief Clear all run state, keeping the allocated arrays for the next run
+     */
+    protected void Reset()
+    {
+        m_Phase = ETeamAutoFormationPhase.IDLE;
+        m_Cursor = 0;
+        m_PlayerIDs.Clear();
+        m_PendingHandles.Clear();
+        m_PendingEntities.Clear();
+        m_PendingX.Clear();
+        m_PendingZ.Clear();
+        m_PendingTargets.Clear();
+        m_PendingIndex.Clear();
+        m_Cells.Clear();
+        m_OpenTeams.Clear();
+        m_OpenTeamX.Clear();
+        m_OpenTeamZ.Clear();
+        m_OpenTeamSpace.Clear();
+        m_OpenTeamIndex.Clear();
+        m_NewGroups.Clear();
+        m_Leftovers.Clear();
+        m_Assignments.Clear();
+        m_RemainingSpace.Clear();
+        m_CheckedGroups.Clear();
+    }
+
+    /**
+     * @brief Get the grid cell key of a world position
+     * @param x World X coordinate
+     * @param z World Z coordinate
+     * @return The cell key
+     */
+    protected static int GetCellKey(float x, float z)
+    {
+        return MakeCellKey(Math.Floor(x / CELL_SIZE), Math.Floor(z / CELL_SIZE));
+    }
+
+    /**
+     * @brief Pack grid cell coordinates into a key
+     * @param cellX Cell X coordinate
+     * @param cellZ Cell Z coordinate
+     * @return The cell key
+     */
+    protected static int MakeCellKey(int cellX, int cellZ)
+    {
+        return ((cellX & 0xFFFF) << 16) | (cellZ & 0xFFFF);
+    }
+}
@@ -0,0 +1,273 @@
+/**
+ * @brief Collects outbound team chat on the server until the next network tick
+ *
+ * Messages are grouped into one batch per team. Each batch keeps a small sender table so
+ * a sender's handle and name are written once per batch no matter how many messages they
+ * sent, and messages refer to senders by table index. Team pings are batched the same way
+ * and share the sender table. Batches and their arrays are pooled and reused after every flush.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+#include "TeamPing.c"
+class TeamChatBatcher
+{
+    // Batch index by team ID for the current tick
+    protected ref map<int, int> m_BatchIndex = new map<int, int>();
+
+    // Number of batches in use this tick; pooled batches beyond it are empty
+    protected int m_BatchCount = 0;
+
+    // Per batch: team ID
+    protected ref array<int> m_TeamIDs = new array<int>();
+
+    // Per batch: sender table (handle and name)
+    protected ref array<ref array<int>> m_SenderHandles = new array<ref array<int>>();
+    protected ref array<ref array<string>> m_SenderNames = new array<ref array<string>>();
+
+    // Per batch: messages as sender table index and text
+    protected ref array<ref array<int>> m_MessageSenders = new array<ref array<int>>();
+    protected ref array<ref array<string>> m_MessageTexts = new array<ref array<string>>();
+
+    // Per batch: pings as sender table index, type and position
+    protected ref array<ref array<int>> m_PingSenders = new array<ref array<int>>();
+    protected ref array<ref array<int>> m_PingTypes = new array<ref array<int>>();
+    protected ref array<ref array<vector>> m_PingPositions = new array<ref array<vector>>();
+
+    /**
+     * @brief Queue a message for the team's next batch
+     * @param teamID The team ID
+     * @param senderHandle The player handle of the sender
+     * @param senderName The name of the sender
+     * @param messageText The text of the message
+     */
+    void Queue(int teamID, int senderHandle, string senderName, string messageText)
+    {
+        int batch = GetBatch(teamID);
+        m_MessageSenders[batch].Insert(GetSender(batch, senderHandle, senderName));
+        m_MessageTexts[batch].Insert(messageText);
+    }
+
+    /**
+     * @brief Queue a ping for the team's next batch
+     * @param teamID The team ID
+     * @param senderHandle The player handle of the sender
+     * @param senderName The name of the sender
+     * @param type The ping type
+     * @param position The world position
+     */
+    void QueuePing(int teamID, int senderHandle, string senderName, ETeamPingType type, vector position)
+    {
+        int batch = GetBatch(teamID);
+        m_PingSenders[batch].Insert(GetSender(batch, senderHandle, senderName));
+        m_PingTypes[batch].Insert(type);
+        m_PingPositions[batch].Insert(position);
+    }
+
+    /**
+     * @brief Empty all batches after they were sent, keeping their storage
+     */
+    void Clear()
+    {
+        for (int batch = 0; batch < m_BatchCount; batch++)
+        {
+            m_SenderHandles[batch].Clear();
+            m_SenderNames[batch].Clear();
+            m_MessageSenders[batch].Clear();
+            m_MessageTexts[batch].Clear();
+            m_PingSenders[batch].Clear();
+            m_PingTypes[batch].Clear();
+            m_PingPositions[batch].Clear();
+        }
+
+        m_BatchIndex.Clear();
+        m_BatchCount = 0;
+    }
+
+    /**
+     * @brief Get the number of batches queued this tick
+     * @return The batch count
+     */
+    int GetBatchCount()
+    {
+        return m_BatchCount;
+    }
+
+    /**
+     * @brief Get the team a batch is addressed to
+     * @param batch The batch index
+     * @return The team ID
+     */
+    int GetTeamID(int batch)
+    {
+        return m_TeamIDs[batch];
+    }
+
+    /**
+     * @brief Get the number of distinct senders in a batch
+     * @param batch The batch index
+     * @return The sender count
+     */
+    int GetSenderCount(int batch)
+    {
+        return m_SenderHandles[batch].Count();
+    }
+
+    /**
+     * @brief Get the player handle of a sender table entry
+     * @param batch The batch index
+     * @param sender The sender table index
+     * @return The player handle
+     */
+    int GetSenderHandle(int batch, int sender)
+    {
+        return m_SenderHandles[batch][sender];
+    }
+
+    /**
+     * @brief Get the name of a sender table entry
+     * @param batch The batch index
+     * @param sender The sender table index
+     * @return The sender name
+     */
+    string GetSenderName(int batch, int sender)
+    {
+        return m_SenderNames[batch][sender];
+    }
+
+    /**
+     * @brief Get the number of messages in a batch
+     * @param batch The batch index
+     * @return The message count
+     */
+    int GetMessageCount(int batch)
+    {
+        return m_MessageTexts[batch].Count();
+    }
+
+    /**
+     * @brief Get the sender table index of a message
+     * @param batch The batch index
+     * @param message The message index
+     * @return The sender table index
+     */
+    int GetMessageSender(int batch, int message)
+    {
+        return m_MessageSenders[batch][message];
+    }
+
+    /**
+     * @brief Get the text of a message
+     * @param batch The batch index
+     * @param message The message index
+     * @return The message text
+     */
+    string GetMessageText(int batch, int message)
+    {
+        return m_MessageTexts[batch][message];
+    }
+
+    /**
+     * @brief Get the number of pings in a batch
+     * @param batch The batch index
+     * @return The ping count
+     */
+    int GetPingCount(int batch)
+    {
+        return m_PingTypes[batch].Count();
+    }
+
+    /**
+     * @brief Get the sender table index of a ping
+     * @param batch The batch index
+     * @param ping The ping index
+     * @return The sender table index
+     */
+    int GetPingSender(int batch, int ping)
+    {
+        return m_PingSenders[batch][ping];
+    }
+
+    /**
+     * @brief Get the type of a ping
+     * @param batch The batch index
+     * @param ping The ping index
+     * @return The ping type
+     */
+    ETeamPingType GetPingType(int batch, int ping)
+    {
+        return m_PingTypes[batch][ping];
+    }
+
+    /**
+     * @brief Get the position of a ping
+     * @param batch The batch index
+     * @param ping The ping index
+     * @return The world position
+     */
+    vector GetPingPosition(int batch, int ping)
+    {
+        return m_PingPositions[batch][ping];
+    }
+
+    /**
+     * @brief Get the batch of a team for this tick, starting one if needed
+     * @param teamID The team ID
+     * @return The batch index
+     */
+    protected int GetBatch(int teamID)
+    {
+        int batch;
+        if (!m_BatchIndex.Find(teamID, batch))
+        {
+            batch = AcquireBatch();
+            m_TeamIDs[batch] = teamID;
+            m_BatchIndex.Set(teamID, batch);
+        }
+
+        return batch;
+    }
+
+    /**
+     * @brief Get a sender's index in a batch's sender table, adding the sender if needed
+     * @param batch The batch index
+     * @param senderHandle The player handle of the sender
+     * @param senderName The name of the sender
+     * @return The sender table index
+     */
+    protected int GetSender(int batch, int senderHandle, string senderName)
+    {
+        array<int> senderHandles = m_SenderHandles[batch];
+        int sender = senderHandles.Find(senderHandle);
+        if (sender == -1)
+        {
+            sender = senderHandles.Insert(senderHandle);
+            m_SenderNames[batch].Insert(senderName);
+        }
+
+        return sender;
+    }
+
+    /**
+     * @brief Take the next pooled batch, creating one when the pool is exhausted
+     * @return The batch index
+     */
+    protected int AcquireBatch()
+    {
+        int batch = m_BatchCount;
+        m_BatchCount++;
+
+        if (batch < m_TeamIDs.Count())
+            return batch;
+
+        m_TeamIDs.Insert(0);
+        m_SenderHandles.Insert(new array<int>());
+        m_SenderNames.Insert(new array<string>());
+        m_MessageSenders.Insert(new array<int>());
+        m_MessageTexts.Insert(new array<string>());
+        m_PingSenders.Insert(new array<int>());
+        m_PingTypes.Insert(new array<int>());
+        m_PingPositions.Insert(new array<vector>());
+        return batch;
+    }
+}
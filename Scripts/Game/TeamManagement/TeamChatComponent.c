@@ -12,6 +12,10 @@
 #include "../Core/Game.c"
 #include "../Core/GenericComponent.c"
 #include "../Core/ScriptComponent.c"
+#include "TeamManagementSettings.c"
+#include "TeamChatHistory.c"
+#include "TeamChatSequencer.c"
+#include "TeamPingDisplay.c"
 class TeamChatComponentClass : ScriptComponentClass
 {
 }
@@ -22,20 +26,44 @@ class TeamChatComponentClass : ScriptComponentClass
 */
 class TeamChatComponent : ScriptComponent
 {
-    // Maximum number of chat messages to store in history
-    protected const int MAX_CHAT_HISTORY = 50;
-    
-    // Maximum character length of a chat message
-    protected const int MAX_MESSAGE_LENGTH = 128;
-    
     // Time in seconds that a chat message remains visible
     protected const float MESSAGE_DISPLAY_TIME = 10.0;
     
+    // Time in seconds over which an expiring message fades out (part of MESSAGE_DISPLAY_TIME)
+    protected const float MESSAGE_FADE_TIME = 2.0;
+    
+    // Number of row widgets in the chat layout (ChatRow0 .. ChatRow9)
+    protected const int CHAT_ROW_COUNT = 10;
+    
+    // Interval in milliseconds between fade updates while rows are visible
+    protected const int CHAT_REFRESH_INTERVAL_MS = 100;
+    
+    // Time in milliseconds a message waits for an earlier missing one before it is shown anyway
+    protected const int CHAT_REORDER_TIMEOUT_MS = 500;
+    
+    // Chat components of players in each team, by team ID; delivery iterates these lists
+    protected static ref map<int, ref array<TeamChatComponent>> s_TeamComponents = new map<int, ref array<TeamChatComponent>>();
+    
+    // Chat component of the locally controlled player
+    protected static TeamChatComponent s_LocalComponent;
+    
     // Reference to team manager
     protected ref TeamManager m_TeamManager;
     
-    // Reference to chat message history (cached locally)
-    protected ref array<ref TeamChatMessage> m_ChatHistory = new array<ref TeamChatMessage>();
+    // Chat message history (cached locally), preallocated at init
+    protected ref TeamChatHistory m_ChatHistory;
+    
+    // Restores the server's order of sequenced messages and drops duplicates
+    protected ref TeamChatSequencer m_ChatSequencer = new TeamChatSequencer();
+    
+    // Scratch message for replaying messages released by the sequencer
+    protected ref TeamChatMessage m_ReorderedMessage = new TeamChatMessage();
+    
+    // Whether the reorder timeout is pending
+    protected bool m_ReorderScheduled = false;
+    
+    // Map and HUD markers for the team's pings; local player only
+    protected ref TeamPingDisplay m_PingDisplay;
     
     // Network component for multiplayer support
     protected ref TeamNetworkComponent m_NetworkComponent;
@@ -46,8 +74,14 @@ class TeamChatComponent : ScriptComponent
     // Input widget for typing messages
     protected ref EditBoxWidget m_InputBox;
     
-    // Chat message display widget
-    protected ref TextListboxWidget m_ChatDisplay;
+    // Fixed pool of chat row widgets, oldest visible message at the top
+    protected ref array<TextWidget> m_ChatRows = new array<TextWidget>();
+    
+    // Per row: sequence number of the history message it shows, -1 when released
+    protected ref array<int> m_RowSequences = new array<int>();
+    
+    // Whether the fade timer is running
+    protected bool m_RefreshScheduled = false;
     
     // Is the chat input currently active
     protected bool m_InputActive = false;
@@ -66,6 +100,9 @@ class TeamChatComponent : ScriptComponent
         // Store reference to player entity
         m_PlayerEntity = owner;
         
+        // Allocate all history slots up front so incoming messages never allocate
+        m_ChatHistory = new TeamChatHistory(TeamManagementSettings.Get().m_MaxChatHistory);
+        
         // Get team manager
         m_TeamManager = TeamManager.GetInstance();
         if (!m_TeamManager)
@@ -83,8 +120,16 @@ class TeamChatComponent : ScriptComponent
         // Create and configure UI
         CreateChatUI();
         
-        // Get current team ID
+        // Get current team ID and register for delivery to that team
         UpdateTeamID();
+        RegisterForTeam(m_CurrentTeamID);
+        
+        PlayerController playerController = PlayerController.Cast(owner.GetController());
+        if (playerController && playerController.IsLocalPlayer())
+        {
+            s_LocalComponent = this;
+            m_PingDisplay = new TeamPingDisplay();
+        }
         
         // Register for team change events
         if (m_TeamManager)
@@ -94,6 +139,11 @@ class TeamChatComponent : ScriptComponent
     //------------------------------------------------------------------------------------------------
     void ~TeamChatComponent()
     {
+        // Stop receiving deliveries
+        UnregisterFromTeam(m_CurrentTeamID);
+        if (s_LocalComponent == this)
+            s_LocalComponent = null;
+        
         // Unregister from team change events
         if (m_TeamManager)
             m_TeamManager.GetOnTeamChanged().Remove(OnTeamChanged);
@@ -101,6 +151,12 @@ class TeamChatComponent : ScriptComponent
         // Unregister input handlers
         UnregisterInputs();
         
+        // Stop the fade timer and the reorder timeout
+        if (m_RefreshScheduled)
+            GetGame().GetCallQueue().Remove(RefreshChatRows);
+        if (m_ReorderScheduled)
+            GetGame().GetCallQueue().Remove(OnChatReorderTimeout);
+        
         // Clean up UI
         if (m_ChatWidget)
         {
@@ -122,7 +178,17 @@ class TeamChatComponent : ScriptComponent
         if (m_PlayerEntity.GetID() != entityID)
             return;
             
-        // Update team ID
+        // Update team ID; the new team's chat has its own sequence
+        if (m_CurrentTeamID != newTeamID)
+        {
+            m_ChatSequencer.Reset();
+            if (m_PingDisplay)
+                m_PingDisplay.Clear();
+
+            UnregisterFromTeam(m_CurrentTeamID);
+            RegisterForTeam(newTeamID);
+        }
+            
         m_CurrentTeamID = newTeamID;
         
         // Notify player about team chat availability
@@ -136,6 +202,67 @@ class TeamChatComponent : ScriptComponent
         }
     }
     
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Get the chat components of a team's players
+     * @param teamID The team ID
+     * @return The registered components, or null if there are none; do not modify
+     */
+    static array<TeamChatComponent> GetTeamComponents(int teamID)
+    {
+        return s_TeamComponents.Get(teamID);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Get the chat component of the locally controlled player
+     * @return The local chat component, or null on a dedicated server
+     */
+    static TeamChatComponent GetLocalComponent()
+    {
+        return s_LocalComponent;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Add this component to a team's delivery list
+     * @param teamID The team ID
+     */
+    protected void RegisterForTeam(int teamID)
+    {
+        if (teamID <= 0)
+            return;
+            
+        array<TeamChatComponent> components = s_TeamComponents.Get(teamID);
+        if (!components)
+        {
+            components = new array<TeamChatComponent>();
+            s_TeamComponents.Set(teamID, components);
+        }
+        
+        if (components.Find(this) == -1)
+            components.Insert(this);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Remove this component from a team's delivery list
+     * @param teamID The team ID
+     */
+    protected void UnregisterFromTeam(int teamID)
+    {
+        if (teamID <= 0)
+            return;
+            
+        array<TeamChatComponent> components = s_TeamComponents.Get(teamID);
+        if (!components)
+            return;
+            
+        components.RemoveItem(this);
+        if (components.IsEmpty())
+            s_TeamComponents.Remove(teamID);
+    }
+    
     //------------------------------------------------------------------------------------------------
     /**
      * @brief Update the current team ID
@@ -256,6 +383,9 @@ class TeamChatComponent : ScriptComponent
         m_InputBox.SetText("");
         m_InputBox.SetFocus(true);
         m_InputActive = true;
+        
+        // Bring back recent messages while typing
+        RefreshChatRows();
     }
     
     //------------------------------------------------------------------------------------------------
@@ -271,6 +401,9 @@ class TeamChatComponent : ScriptComponent
         m_InputBox.SetVisible(false);
         m_InputBox.SetFocus(false);
         m_InputActive = false;
+        
+        // Let old messages fade again
+        RefreshChatRows();
     }
     
     //------------------------------------------------------------------------------------------------
@@ -293,12 +426,23 @@ class TeamChatComponent : ScriptComponent
         }
         
         // Get child widgets
-        m_ChatDisplay = TextListboxWidget.Cast(m_ChatWidget.FindAnyWidget("ChatDisplay"));
         m_InputBox = EditBoxWidget.Cast(m_ChatWidget.FindAnyWidget("InputBox"));
+        for (int i = 0; i < CHAT_ROW_COUNT; i++)
+        {
+            TextWidget row = TextWidget.Cast(m_ChatWidget.FindAnyWidget("ChatRow" + i));
+            if (!row)
+                break;
+            
+            row.SetVisible(false);
+            m_ChatRows.Insert(row);
+            m_RowSequences.Insert(-1);
+        }
         
-        if (!m_ChatDisplay || !m_InputBox)
+        if (!m_InputBox || m_ChatRows.Count() != CHAT_ROW_COUNT)
         {
             Print("ERROR: Could not find all required chat widgets!");
+            m_ChatRows.Clear();
+            m_RowSequences.Clear();
             return;
         }
         
@@ -328,9 +472,10 @@ class TeamChatComponent : ScriptComponent
         messageText = messageText.Trim();
         if (messageText != "")
         {
-            // Limit message length
-            if (messageText.Length() > MAX_MESSAGE_LENGTH)
-                messageText = messageText.Substring(0, MAX_MESSAGE_LENGTH);
+            // Limit message length (the server enforces this as well)
+            int maxLength = TeamManagementSettings.Get().m_MaxMessageLength;
+            if (messageText.Length() > maxLength)
+                messageText = messageText.Substring(0, maxLength);
                 
             // Send the message
             SendTeamChatMessage(messageText);
@@ -370,6 +515,52 @@ class TeamChatComponent : ScriptComponent
         DistributeTeamChatMessage(message);
     }
     
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Drop a ping for the team
+     * @param type The ping type
+     * @param position The world position
+     */
+    void SendTeamPing(ETeamPingType type, vector position)
+    {
+        if (m_CurrentTeamID <= 0)
+            return;
+            
+        // In multiplayer, the server checks the rate limit and batches the ping
+        if (GetGame().IsMultiplayer() && m_NetworkComponent)
+        {
+            m_NetworkComponent.SendTeamPing(m_PlayerEntity.GetID(), type, position);
+            return;
+        }
+        
+        // In single player, deliver to the registered team members directly
+        array<TeamChatComponent> components = s_TeamComponents.Get(m_CurrentTeamID);
+        if (!components)
+            return;
+            
+        vector quantized = TeamPing.Quantize(position);
+        foreach (TeamChatComponent chatComponent : components)
+        {
+            chatComponent.ReceiveTeamPing(m_CurrentTeamID, type, quantized, GetPlayerName());
+        }
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Receive a team ping
+     * @param teamID The team the ping was sent to
+     * @param type The ping type
+     * @param position The world position
+     * @param senderName The name of the player who pinged
+     */
+    void ReceiveTeamPing(int teamID, ETeamPingType type, vector position, string senderName)
+    {
+        if (!m_PingDisplay || m_CurrentTeamID != teamID)
+            return;
+            
+        m_PingDisplay.Show(type, position, senderName);
+    }
+    
     //------------------------------------------------------------------------------------------------
     /**
      * @brief Distribute a team chat message to appropriate players
@@ -389,28 +580,15 @@ class TeamChatComponent : ScriptComponent
         // In single player, server, or host mode, distribute to all team members
         if (!GetGame().IsMultiplayer() || GetGame().IsServer())
         {
-            // Get all players in the team
-            array<ref TeamMember> teamMembers = m_TeamManager.GetTeamMembers(message.GetTeamID());
-            if (!teamMembers)
+            // Distribute to all registered team members except the sender (already displayed locally)
+            array<TeamChatComponent> components = s_TeamComponents.Get(message.GetTeamID());
+            if (!components)
                 return;
                 
-            // Distribute to all team members except the sender
-            foreach (ref TeamMember member : teamMembers)
+            foreach (TeamChatComponent chatComponent : components)
             {
-                // Skip the sender (already displayed locally)
-                if (member.GetPlayerID() == message.GetSenderID())
-                    continue;
-                    
-                // Get the player entity and send the message
-                IEntity playerEntity = GetGame().GetPlayerManager().GetPlayerByPlayerId(member.GetPlayerID());
-                if (playerEntity)
-                {
-                    TeamChatComponent chatComponent = TeamChatComponent.Cast(playerEntity.FindComponent(TeamChatComponent));
-                    if (chatComponent)
-                    {
-                        chatComponent.ReceiveTeamChatMessage(message);
-                    }
-                }
+                if (chatComponent != this)
+                    chatComponent.ReceiveTeamChatMessage(message);
             }
         }
     }
@@ -429,6 +607,61 @@ class TeamChatComponent : ScriptComponent
         if (m_CurrentTeamID != message.GetTeamID())
             return;
             
+        // Messages delivered without going through the server have no sequence
+        if (message.GetSequence() < 0)
+        {
+            ShowReceivedMessage(message);
+            return;
+        }
+        
+        // A message the window cannot hold means the gap will not fill; show what is waiting first
+        if (m_ChatSequencer.IsBeyondWindow(message.GetSequence()))
+            ShowPendingMessages(true);
+            
+        if (m_ChatSequencer.Offer(message))
+        {
+            ShowReceivedMessage(message);
+            ShowPendingMessages(false);
+        }
+        
+        // Don't hold messages back indefinitely for one that may never arrive
+        if (m_ChatSequencer.HasPending() && !m_ReorderScheduled)
+        {
+            GetGame().GetCallQueue().CallLater(OnChatReorderTimeout, CHAT_REORDER_TIMEOUT_MS, false);
+            m_ReorderScheduled = true;
+        }
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Show messages the sequencer released
+     * @param skipGaps If true, messages still missing are given up on
+     */
+    protected void ShowPendingMessages(bool skipGaps)
+    {
+        while (m_ChatSequencer.PopPending(m_ReorderedMessage, skipGaps))
+        {
+            ShowReceivedMessage(m_ReorderedMessage);
+        }
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Show the messages still waiting once the reorder timeout expired
+     */
+    protected void OnChatReorderTimeout()
+    {
+        m_ReorderScheduled = false;
+        ShowPendingMessages(true);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Add a message to the history and display it
+     * @param message The message to show
+     */
+    protected void ShowReceivedMessage(TeamChatMessage message)
+    {
         // Add to local chat history
         AddChatMessageToHistory(message);
         
@@ -443,37 +676,120 @@ class TeamChatComponent : ScriptComponent
      */
     protected void AddChatMessageToHistory(TeamChatMessage message)
     {
-        if (!message)
+        if (!message || !m_ChatHistory)
             return;
             
-        // Add to history
-        m_ChatHistory.Insert(message);
-        
-        // Trim history if too large
-        while (m_ChatHistory.Count() > MAX_CHAT_HISTORY)
-        {
-            m_ChatHistory.Remove(0);
-        }
+        // Overwrites the oldest entry once the history is full
+        m_ChatHistory.Push(message.GetTeamID(), message.GetSenderID(), message.GetSenderName(), message.GetMessageText(), message.GetTimestamp());
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Get the chat message history
+     * @return The chat history, oldest message first
+     */
+    TeamChatHistory GetChatHistory()
+    {
+        return m_ChatHistory;
     }
     
     //------------------------------------------------------------------------------------------------
     /**
      * @brief Display a chat message in the UI
+     * The message is already in the history; the rows are re-bound to the newest messages.
      * @param message The message to display
      */
     protected void DisplayChatMessage(TeamChatMessage message)
     {
-        if (!message || !m_ChatDisplay)
+        if (!message)
             return;
             
-        // Format the message for display
-        string displayText = "[Team] " + message.GetSenderName() + ": " + message.GetMessageText();
+        RefreshChatRows();
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Bind the row widgets to the newest unexpired history messages and update their fade
+     * Only rows whose message changed get new text. While the input is open, the newest messages
+     * are shown regardless of age. The timer keeps running only while something is visible.
+     */
+    protected void RefreshChatRows()
+    {
+        if (m_ChatRows.Count() == 0 || !m_ChatHistory)
+            return;
+            
+        float currentTime = GetGame().GetWorld().GetWorldTime();
+        int count = m_ChatHistory.GetCount();
+        int row = 0;
         
-        // Add to chat display
-        m_ChatDisplay.AddItem(displayText);
+        for (int i = Math.Max(count - CHAT_ROW_COUNT, 0); i < count; i++)
+        {
+            float opacity = 1.0;
+            if (!m_InputActive)
+            {
+                float remaining = MESSAGE_DISPLAY_TIME - (currentTime - m_ChatHistory.GetTimestamp(i));
+                if (remaining <= 0)
+                    continue; // Expired
+                    
+                opacity = Math.Clamp(remaining / MESSAGE_FADE_TIME, 0.0, 1.0);
+            }
+            
+            BindChatRow(row, i, opacity);
+            row++;
+        }
         
-        // Scroll to the bottom
-        m_ChatDisplay.EnsureVisible(m_ChatDisplay.GetItemCount() - 1);
+        bool anyVisible = row > 0;
+        for (; row < CHAT_ROW_COUNT; row++)
+        {
+            ReleaseChatRow(row);
+        }
+        
+        // Fading needs periodic updates; stop once everything is gone or fully shown
+        bool needsTimer = anyVisible && !m_InputActive;
+        if (needsTimer && !m_RefreshScheduled)
+            GetGame().GetCallQueue().CallLater(RefreshChatRows, CHAT_REFRESH_INTERVAL_MS, true);
+        else if (!needsTimer && m_RefreshScheduled)
+            GetGame().GetCallQueue().Remove(RefreshChatRows);
+            
+        m_RefreshScheduled = needsTimer;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Show a history message in a row widget
+     * @param row The row index
+     * @param index The history message index
+     * @param opacity The row opacity
+     */
+    protected void BindChatRow(int row, int index, float opacity)
+    {
+        TextWidget rowWidget = m_ChatRows[row];
+        int sequence = m_ChatHistory.GetSequence(index);
+        if (m_RowSequences[row] != sequence)
+        {
+            // Text is only formatted when a row starts showing a different message
+            rowWidget.SetText("[Team] " + m_ChatHistory.GetSenderName(index) + ": " + m_ChatHistory.GetMessageText(index));
+            rowWidget.SetVisible(true);
+            m_RowSequences[row] = sequence;
+        }
+        
+        rowWidget.SetOpacity(opacity);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Hide a row widget and drop its text
+     * @param row The row index
+     */
+    protected void ReleaseChatRow(int row)
+    {
+        if (m_RowSequences[row] == -1)
+            return;
+            
+        TextWidget rowWidget = m_ChatRows[row];
+        rowWidget.SetVisible(false);
+        rowWidget.SetText("");
+        m_RowSequences[row] = -1;
     }
     
     //------------------------------------------------------------------------------------------------
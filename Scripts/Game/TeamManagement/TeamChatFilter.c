@@ -0,0 +1,287 @@
+/**
+ * @brief Server-side keyword filter for team chat
+ *
+ * The word list is compiled once into an Aho-Corasick automaton: a trie of all words whose
+ * states carry a failure link to the longest proper suffix that is also a trie prefix, and
+ * the length of the longest word ending there. Filtering walks the message once, following
+ * failure links on mismatches, so it runs in time linear in the message length regardless of
+ * how many words are listed. Matches are masked with asterisks, ignoring ASCII case.
+ *
+ * The list is read from a text file in the profile folder, one word per line (`//` starts a
+ * comment). Reload recompiles only when the file content changed, so it can be polled.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+class TeamChatFilter
+{
+    // Default word list file in the profile folder
+    static const string DEFAULT_PATH = "$profile:TeamChatFilter.txt";
+
+    // Byte values per state in the edge key
+    protected static const int ALPHABET_SIZE = 256;
+
+    // Trie edges, keyed by state * ALPHABET_SIZE + byte
+    protected ref map<int, int> m_Edges = new map<int, int>();
+
+    // Per state: failure link, longest word length ending here (0 if none)
+    protected ref array<int> m_Fail = new array<int>();
+    protected ref array<int> m_MatchLengths = new array<int>();
+
+    // Per state: first child, next sibling and the byte leading into it; used to compile only
+    protected ref array<int> m_FirstChild = new array<int>();
+    protected ref array<int> m_NextSibling = new array<int>();
+    protected ref array<int> m_EdgeBytes = new array<int>();
+
+    // Per character of the message being filtered: whether it is masked
+    protected ref array<bool> m_Masked = new array<bool>();
+
+    // Content of the word list the automaton was compiled from
+    protected string m_SourceSignature = "";
+
+    // Number of words compiled
+    protected int m_WordCount = 0;
+
+    // Number of messages in which something was masked
+    protected int m_FilteredCount = 0;
+
+    /**
+     * @brief Constructor; starts with an empty list
+     */
+    void TeamChatFilter()
+    {
+        Compile(new array<string>());
+    }
+
+    /**
+     * @brief Load the word list from a file, recompiling if it changed
+     * A missing file keeps the current list.
+     * @param path The word list file path
+     * @return True if the automaton was recompiled
+     */
+    bool Reload(string path = DEFAULT_PATH)
+    {
+        FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+        if (!file)
+            return false;
+
+        array<string> words = new array<string>();
+        string signature = "";
+        string line;
+        while (file.ReadLine(line) >= 0)
+        {
+            // Also drops the carriage return of lists saved with CRLF line endings
+            line = line.Trim();
+            if (line.IsEmpty() || line.IndexOf("//") == 0)
+                continue;
+
+            words.Insert(line);
+            signature += line + "\n";
+        }
+
+        file.Close();
+
+        if (signature == m_SourceSignature)
+            return false;
+
+        Compile(words);
+        m_SourceSignature = signature;
+        Print("TeamChatFilter: Compiled " + m_WordCount + " words into " + m_Fail.Count() + " states");
+        return true;
+    }
+
+    /**
+     * @brief Mask every listed word in a message
+     * @param messageText The message text; matches are replaced by asterisks in place
+     * @return True if anything was masked
+     */
+    bool Apply(inout string messageText)
+    {
+        if (m_WordCount == 0)
+            return false;
+
+        int length = messageText.Length();
+        m_Masked.Resize(length);
+
+        bool anyMatch = false;
+        int state = 0;
+        for (int i = 0; i < length; i++)
+        {
+            m_Masked[i] = false;
+            state = Step(state, ToLowerByte(messageText.ToAscii(i)));
+
+            int matchLength = m_MatchLengths[state];
+            if (matchLength == 0)
+                continue;
+
+            for (int masked = i - matchLength + 1; masked <= i; masked++)
+            {
+                m_Masked[masked] = true;
+            }
+            anyMatch = true;
+        }
+
+        if (!anyMatch)
+            return false;
+
+        // Copy unmasked runs as substrings, masked characters as asterisks
+        string result = "";
+        int runStart = 0;
+        for (int j = 0; j < length; j++)
+        {
+            if (!m_Masked[j])
+                continue;
+
+            if (j > runStart)
+                result += messageText.Substring(runStart, j - runStart);
+            result += "*";
+            runStart = j + 1;
+        }
+
+        if (runStart < length)
+            result += messageText.Substring(runStart, length - runStart);
+
+        messageText = result;
+        m_FilteredCount++;
+        return true;
+    }
+
+    /**
+     * @brief Get the number of words in the compiled list
+     * @return The word count
+     */
+    int GetWordCount()
+    {
+        return m_WordCount;
+    }
+
+    /**
+     * @brief Get the number of messages in which something was masked
+     * @return The filtered message count
+     */
+    int GetFilteredCount()
+    {
+        return m_FilteredCount;
+    }
+
+    /**
+     * @brief Build the automaton from a word list
+     * @param words The words to match
+     */
+    protected void Compile(array<string> words)
+    {
+        m_Edges.Clear();
+        m_Fail.Clear();
+        m_MatchLengths.Clear();
+        m_FirstChild.Clear();
+        m_NextSibling.Clear();
+        m_EdgeBytes.Clear();
+        m_WordCount = 0;
+
+        // Root
+        AddState(-1, 0);
+
+        // Trie of all words
+        foreach (string word : words)
+        {
+            int length = word.Length();
+            if (length == 0)
+                continue;
+
+            int state = 0;
+            for (int i = 0; i < length; i++)
+            {
+                int byteValue = ToLowerByte(word.ToAscii(i));
+                int next;
+                if (!m_Edges.Find(state * ALPHABET_SIZE + byteValue, next))
+                    next = AddState(state, byteValue);
+
+                state = next;
+            }
+
+            m_MatchLengths[state] = Math.Max(m_MatchLengths[state], length);
+            m_WordCount++;
+        }
+
+        // Failure links in breadth-first order, so a state's fail target is always final
+        array<int> queue = new array<int>();
+        for (int rootChild = m_FirstChild[0]; rootChild != -1; rootChild = m_NextSibling[rootChild])
+        {
+            queue.Insert(rootChild);
+        }
+
+        for (int head = 0; head < queue.Count(); head++)
+        {
+            int parent = queue[head];
+            for (int child = m_FirstChild[parent]; child != -1; child = m_NextSibling[child])
+            {
+                int fail = Step(m_Fail[parent], m_EdgeBytes[child]);
+                m_Fail[child] = fail;
+
+                // A match ending at the suffix also ends here
+                m_MatchLengths[child] = Math.Max(m_MatchLengths[child], m_MatchLengths[fail]);
+                queue.Insert(child);
+            }
+        }
+    }
+
+    /**
+     * @brief Append a state to the trie
+     * @param parent The parent state, -1 for the root
+     * @param byteValue The byte leading from the parent into the state
+     * @return The new state
+     */
+    protected int AddState(int parent, int byteValue)
+    {
+        int state = m_Fail.Insert(0);
+        m_MatchLengths.Insert(0);
+        m_FirstChild.Insert(-1);
+        m_NextSibling.Insert(-1);
+        m_EdgeBytes.Insert(byteValue);
+
+        if (parent >= 0)
+        {
+            m_Edges.Set(parent * ALPHABET_SIZE + byteValue, state);
+            m_NextSibling[state] = m_FirstChild[parent];
+            m_FirstChild[parent] = state;
+        }
+
+        return state;
+    }
+
+    /**
+     * @brief Follow the automaton from a state on one byte
+     * @param state The current state
+     * @param byteValue The next byte
+     * @return The next state
+     */
+    protected int Step(int state, int byteValue)
+    {
+        int next;
+        while (true)
+        {
+            if (m_Edges.Find(state * ALPHABET_SIZE + byteValue, next))
+                return next;
+
+            if (state == 0)
+                return 0;
+
+            state = m_Fail[state];
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Fold ASCII upper case letters to lower case
+     * @param byteValue The byte
+     * @return The folded byte
+     */
+    protected static int ToLowerByte(int byteValue)
+    {
+        if (byteValue >= 65 && byteValue <= 90)
+            return byteValue + 32;
+
+        return byteValue;
+    }
+}
@@ -0,0 +1,248 @@
+/**
+ * @brief Fixed-capacity ring buffer of team chat messages
+ *
+ * All slots are allocated up front. Adding a message writes into the next slot and, once
+ * the buffer is full, overwrites the oldest one, so inserting and evicting are O(1) and a
+ * chat burst does not allocate. Sender IDs and names are interned in a small table that is
+ * reference counted by the slots using them, so a sender who posts many messages is stored once.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+class TeamChatHistory
+{
+    // Number of message slots
+    protected int m_Capacity;
+
+    // Slot the next message is written to
+    protected int m_Head = 0;
+
+    // Number of messages currently stored
+    protected int m_Count = 0;
+
+    // Number of messages ever pushed; gives every message a stable sequence number
+    protected int m_PushedCount = 0;
+
+    // Per slot: team ID, interned sender, message text and timestamp
+    protected ref array<int> m_TeamIDs = new array<int>();
+    protected ref array<int> m_Senders = new array<int>();
+    protected ref array<string> m_Texts = new array<string>();
+    protected ref array<float> m_Timestamps = new array<float>();
+
+    // Interned senders: ID, display name and number of slots referencing the entry
+    protected ref array<string> m_SenderIDs = new array<string>();
+    protected ref array<string> m_SenderNames = new array<string>();
+    protected ref array<int> m_SenderRefCounts = new array<int>();
+
+    // Interned sender index by sender ID
+    protected ref map<string, int> m_SenderLookup = new map<string, int>();
+
+    // Stack of unused sender entries, valid up to m_FreeSenderCount
+    protected ref array<int> m_FreeSenders = new array<int>();
+    protected int m_FreeSenderCount = 0;
+
+    /**
+     * @brief Constructor
+     * @param capacity Number of messages kept; the oldest message is evicted beyond this
+     */
+    void TeamChatHistory(int capacity)
+    {
+        m_Capacity = Math.Max(capacity, 1);
+
+        m_TeamIDs.Resize(m_Capacity);
+        m_Senders.Resize(m_Capacity);
+        m_Texts.Resize(m_Capacity);
+        m_Timestamps.Resize(m_Capacity);
+
+        // Every slot can reference a different sender at most
+        m_SenderIDs.Resize(m_Capacity);
+        m_SenderNames.Resize(m_Capacity);
+        m_SenderRefCounts.Resize(m_Capacity);
+        m_FreeSenders.Resize(m_Capacity);
+
+        for (int i = m_Capacity - 1; i >= 0; i--)
+        {
+            m_SenderRefCounts[i] = 0;
+            m_FreeSenders[m_FreeSenderCount] = i;
+            m_FreeSenderCount++;
+        }
+    }
+
+    /**
+     * @brief Append a message, evicting the oldest one when full
+     * @param teamID The team ID
+     * @param senderID The ID of the sender
+     * @param senderName The name of the sender
+     * @param messageText The text of the message
+     * @param timestamp World time the message was created
+     */
+    void Push(int teamID, string senderID, string senderName, string messageText, float timestamp)
+    {
+        if (m_Count == m_Capacity)
+            ReleaseSender(m_Senders[m_Head]);
+        else
+            m_Count++;
+
+        m_TeamIDs[m_Head] = teamID;
+        m_Senders[m_Head] = AcquireSender(senderID, senderName);
+        m_Texts[m_Head] = messageText;
+        m_Timestamps[m_Head] = timestamp;
+
+        m_Head++;
+        if (m_Head == m_Capacity)
+            m_Head = 0;
+
+        m_PushedCount++;
+    }
+
+    /**
+     * @brief Remove all messages
+     */
+    void Clear()
+    {
+        for (int i = 0; i < m_Count; i++)
+        {
+            int slot = GetSlot(i);
+            ReleaseSender(m_Senders[slot]);
+            m_Texts[slot] = "";
+        }
+
+        m_Head = 0;
+        m_Count = 0;
+    }
+
+    /**
+     * @brief Get the number of stored messages
+     * @return The message count
+     */
+    int GetCount()
+    {
+        return m_Count;
+    }
+
+    /**
+     * @brief Get the number of message slots
+     * @return The capacity
+     */
+    int GetCapacity()
+    {
+        return m_Capacity;
+    }
+
+    /**
+     * @brief Get the sequence number of a message
+     * The number stays the same while the message moves towards index 0, so views can tell
+     * whether a row still shows the same message.
+     * @param index The message index, 0 being the oldest
+     * @return The sequence number
+     */
+    int GetSequence(int index)
+    {
+        return m_PushedCount - m_Count + index;
+    }
+
+    /**
+     * @brief Get the team ID of a message
+     * @param index The message index, 0 being the oldest
+     * @return The team ID
+     */
+    int GetTeamID(int index)
+    {
+        return m_TeamIDs[GetSlot(index)];
+    }
+
+    /**
+     * @brief Get the sender ID of a message
+     * @param index The message index, 0 being the oldest
+     * @return The sender ID
+     */
+    string GetSenderID(int index)
+    {
+        return m_SenderIDs[m_Senders[GetSlot(index)]];
+    }
+
+    /**
+     * @brief Get the sender name of a message
+     * @param index The message index, 0 being the oldest
+     * @return The sender name
+     */
+    string GetSenderName(int index)
+    {
+        return m_SenderNames[m_Senders[GetSlot(index)]];
+    }
+
+    /**
+     * @brief Get the text of a message
+     * @param index The message index, 0 being the oldest
+     * @return The message text
+     */
+    string GetMessageText(int index)
+    {
+        return m_Texts[GetSlot(index)];
+    }
+
+    /**
+     * @brief Get the timestamp of a message
+     * @param index The message index, 0 being the oldest
+     * @return The timestamp
+     */
+    float GetTimestamp(int index)
+    {
+        return m_Timestamps[GetSlot(index)];
+    }
+
+    /**
+     * @brief Map a message index to its ring slot
+     * @param index The message index, 0 being the oldest
+     * @return The slot
+     */
+    protected int GetSlot(int index)
+    {
+        int slot = m_Head - m_Count + index;
+        if (slot < 0)
+            slot += m_Capacity;
+
+        return slot;
+    }
+
+    /**
+     * @brief Get the interned entry of a sender, creating it if needed
+     * @param senderID The ID of the sender
+     * @param senderName The current name of the sender
+     * @return The sender entry index
+     */
+    protected int AcquireSender(string senderID, string senderName)
+    {
+        int sender;
+        if (!m_SenderLookup.Find(senderID, sender))
+        {
+            m_FreeSenderCount--;
+            sender = m_FreeSenders[m_FreeSenderCount];
+            m_SenderIDs[sender] = senderID;
+            m_SenderLookup.Set(senderID, sender);
+        }
+
+        // Names can change during a session; older messages show the latest one
+        m_SenderNames[sender] = senderName;
+        m_SenderRefCounts[sender] = m_SenderRefCounts[sender] + 1;
+        return sender;
+    }
+
+    /**
+     * @brief Drop one reference to a sender entry, freeing it when unused
+     * @param sender The sender entry index
+     */
+    protected void ReleaseSender(int sender)
+    {
+        int refCount = m_SenderRefCounts[sender] - 1;
+        m_SenderRefCounts[sender] = refCount;
+        if (refCount > 0)
+            return;
+
+        m_SenderLookup.Remove(m_SenderIDs[sender]);
+        m_SenderIDs[sender] = "";
+        m_SenderNames[sender] = "";
+        m_FreeSenders[m_FreeSenderCount] = sender;
+        m_FreeSenderCount++;
+    }
+}
@@ -0,0 +1,428 @@
+/**
+ * @brief Server-side team chat log for moderation
+ *
+ * Accepted chat messages are appended to fixed-size segments. Each segment indexes its
+ * records by team and by sender, and records are appended in time order, so a query only
+ * visits segments overlapping the requested time range and binary-searches the team's
+ * records inside them. Recent segments stay in memory for queries; every segment is also
+ * written to its own file in the profile folder.
+ *
+ * Writing happens a few records per world update, so logging never stalls a frame. Segment
+ * files are plain tab-separated text, one record per line, and are not compressed: a
+ * "#segment" header line, a "@handle<TAB>name" line the first time each sender appears, and
+ * per record the time offset from the segment start in tenths of a second, the team ID, the
+ * sender handle and the escaped text.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+#include "TeamChatMessage.c"
+/**
+ * @brief One segment of the chat log with its own indexes
+ */
+class TeamChatLogSegment
+{
+    // Segment number within the session
+    protected int m_SegmentID;
+
+    // World time of the first and last record
+    protected float m_StartTime;
+    protected float m_EndTime;
+
+    // Per record: time, team ID, sender handle and text
+    protected ref array<float> m_Times = new array<float>();
+    protected ref array<int> m_TeamIDs = new array<int>();
+    protected ref array<int> m_SenderHandles = new array<int>();
+    protected ref array<string> m_Texts = new array<string>();
+
+    // Record indices by team ID and by sender handle, in time order
+    protected ref map<int, ref array<int>> m_TeamIndex = new map<int, ref array<int>>();
+    protected ref map<int, ref array<int>> m_SenderIndex = new map<int, ref array<int>>();
+
+    // Sender names seen in this segment
+    protected ref map<int, string> m_SenderNames = new map<int, string>();
+
+    /**
+     * @brief Constructor
+     * @param segmentID Segment number within the session
+     * @param startTime World time of the first record
+     */
+    void TeamChatLogSegment(int segmentID, float startTime)
+    {
+        m_SegmentID = segmentID;
+        m_StartTime = startTime;
+        m_EndTime = startTime;
+    }
+
+    /**
+     * @brief Append a record and index it
+     * @param time World time of the message
+     * @param teamID The team ID
+     * @param senderHandle The player handle of the sender
+     * @param senderName The name of the sender
+     * @param messageText The text of the message
+     */
+    void Append(float time, int teamID, int senderHandle, string senderName, string messageText)
+    {
+        int record = m_Times.Insert(time);
+        m_TeamIDs.Insert(teamID);
+        m_SenderHandles.Insert(senderHandle);
+        m_Texts.Insert(messageText);
+        m_EndTime = time;
+
+        AddToIndex(m_TeamIndex, teamID, record);
+        AddToIndex(m_SenderIndex, senderHandle, record);
+        m_SenderNames.Set(senderHandle, senderName);
+    }
+
+    /**
+     * @brief Collect the records of a team within a time range
+     * @param teamID The team ID
+     * @param fromTime Start of the range (inclusive)
+     * @param toTime End of the range (inclusive)
+     * @param results Receives the messages, oldest first
+     */
+    void QueryTeam(int teamID, float fromTime, float toTime, notnull array<ref TeamChatMessage> results)
+    {
+        Collect(m_TeamIndex.Get(teamID), fromTime, toTime, results);
+    }
+
+    /**
+     * @brief Collect the records of a sender within a time range
+     * @param senderHandle The player handle of the sender
+     * @param fromTime Start of the range (inclusive)
+     * @param toTime End of the range (inclusive)
+     * @param results Receives the messages, oldest first
+     */
+    void QuerySender(int senderHandle, float fromTime, float toTime, notnull array<ref TeamChatMessage> results)
+    {
+        Collect(m_SenderIndex.Get(senderHandle), fromTime, toTime, results);
+    }
+
+    /**
+     * @brief Check if the segment may contain records within a time range
+     * @param fromTime Start of the range
+     * @param toTime End of the range
+     * @return True if the segment overlaps the range
+     */
+    bool Overlaps(float fromTime, float toTime)
+    {
+        return m_StartTime <= toTime && m_EndTime >= fromTime;
+    }
+
+    /**
+     * @brief Format a record as one tab-separated text line of the segment file
+     * The first record of each sender is preceded by a sender name line.
+     * @param record The record index
+     * @param writtenSenders Senders already named in the file
+     * @return The line(s) to write
+     */
+    string FormatRecord(int record, notnull set<int> writtenSenders)
+    {
+        int senderHandle = m_SenderHandles[record];
+        string prefix = "";
+        if (writtenSenders.Insert(senderHandle))
+            prefix = "@" + senderHandle + "\t" + Escape(m_SenderNames.Get(senderHandle)) + "\n";
+
+        int offset = Math.Round((m_Times[record] - m_StartTime) * 10);
+        return prefix + offset + "\t" + m_TeamIDs[record] + "\t" + senderHandle + "\t" + Escape(m_Texts[record]);
+    }
+
+    /**
+     * @brief Get the header line of the segment file
+     * @return The header line
+     */
+    string FormatHeader()
+    {
+        return "#segment\t" + m_SegmentID + "\t" + m_StartTime;
+    }
+
+    /**
+     * @brief Get the number of records
+     * @return The record count
+     */
+    int GetRecordCount()
+    {
+        return m_Times.Count();
+    }
+
+    /**
+     * @brief Get the segment number
+     * @return The segment ID
+     */
+    int GetSegmentID()
+    {
+        return m_SegmentID;
+    }
+
+    /**
+     * @brief Get the world time of the last record
+     * @return The end time
+     */
+    float GetEndTime()
+    {
+        return m_EndTime;
+    }
+
+    /**
+     * @brief Append indexed records within a time range to the results
+     * @param records Record indices in time order, or null
+     * @param fromTime Start of the range (inclusive)
+     * @param toTime End of the range (inclusive)
+     * @param results Receives the messages
+     */
+    protected void Collect(array<int> records, float fromTime, float toTime, array<ref TeamChatMessage> results)
+    {
+        if (!records)
+            return;
+
+        // Binary search the first record at or after fromTime
+        int low = 0;
+        int high = records.Count();
+        while (low < high)
+        {
+            int middle = (low + high) / 2;
+            if (m_Times[records[middle]] < fromTime)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        for (int i = low; i < records.Count(); i++)
+        {
+            int record = records[i];
+            if (m_Times[record] > toTime)
+                break;
+
+            int senderHandle = m_SenderHandles[record];
+            TeamChatMessage message = new TeamChatMessage(m_TeamIDs[record], senderHandle.ToString(), m_SenderNames.Get(senderHandle), m_Texts[record]);
+            results.Insert(message);
+        }
+    }
+
+    /**
+     * @brief Add a record to an index list
+     * @param index The index map
+     * @param key The index key
+     * @param record The record index
+     */
+    protected static void AddToIndex(map<int, ref array<int>> index, int key, int record)
+    {
+        array<int> records = index.Get(key);
+        if (!records)
+        {
+            records = new array<int>();
+            index.Set(key, records);
+        }
+
+        records.Insert(record);
+    }
+
+    /**
+     * @brief Escape separators so a value stays on one line and in one field
+     * @param value The value to escape
+     * @return The escaped value
+     */
+    protected static string Escape(string value)
+    {
+        value.Replace("\\", "\\\\");
+        value.Replace("\t", "\\t");
+        value.Replace("\n", "\\n");
+        return value;
+    }
+}
+
+/**
+ * @brief Segmented, indexed chat log with time-sliced file writing
+ */
+class TeamChatLog
+{
+    // Records per segment
+    protected static const int SEGMENT_RECORDS = 1024;
+
+    // Segments kept in memory for queries; older ones only exist on disk
+    protected static const int MAX_SEGMENTS_IN_MEMORY = 64;
+
+    // Records written to disk per world update
+    protected static const int RECORDS_WRITTEN_PER_UPDATE = 32;
+
+    // Folder in the profile the segment files are written to
+    protected static const string LOG_DIRECTORY = "$profile:TeamChatLog";
+
+    // Segments in memory, oldest first; the last one receives new records
+    protected ref array<ref TeamChatLogSegment> m_Segments = new array<ref TeamChatLogSegment>();
+
+    // Segments not yet fully written, oldest first
+    protected ref array<ref TeamChatLogSegment> m_WriteQueue = new array<ref TeamChatLogSegment>();
+
+    // Records of the first queued segment already written
+    protected int m_WrittenRecords = 0;
+
+    // File of the segment being written
+    protected FileHandle m_File;
+
+    // Senders already named in the current file
+    protected ref set<int> m_WrittenSenders = new set<int>();
+
+    // Session identifier used in file names
+    protected int m_SessionID;
+
+    // Number of segments created this session
+    protected int m_SegmentCount = 0;
+
+    /**
+     * @brief Constructor
+     */
+    void TeamChatLog()
+    {
+        m_SessionID = System.GetUnixTime();
+        FileIO.MakeDirectory(LOG_DIRECTORY);
+    }
+
+    /**
+     * @brief Destructor; writes whatever is still queued
+     */
+    void ~TeamChatLog()
+    {
+        while (m_WriteQueue.Count() > 0)
+        {
+            WriteRecords(SEGMENT_RECORDS, true);
+        }
+    }
+
+    /**
+     * @brief Append a message to the log
+     * Only memory is touched here; the record reaches the disk in a later Update.
+     * @param teamID The team ID
+     * @param senderHandle The player handle of the sender
+     * @param senderName The name of the sender
+     * @param messageText The text of the message
+     * @param time World time of the message
+     */
+    void Append(int teamID, int senderHandle, string senderName, string messageText, float time)
+    {
+        TeamChatLogSegment segment;
+        if (m_Segments.Count() > 0)
+            segment = m_Segments[m_Segments.Count() - 1];
+
+        if (!segment || segment.GetRecordCount() >= SEGMENT_RECORDS)
+            segment = StartSegment(time);
+
+        segment.Append(time, teamID, senderHandle, senderName, messageText);
+    }
+
+    /**
+     * @brief Write queued records to disk within the per-update budget
+     * Called by the world module once per update on the server.
+     */
+    void Update()
+    {
+        if (m_WriteQueue.Count() > 0)
+            WriteRecords(RECORDS_WRITTEN_PER_UPDATE);
+    }
+
+    /**
+     * @brief Get the messages of a team within a time range
+     * @param teamID The team ID
+     * @param fromTime Start of the range (world time, inclusive)
+     * @param toTime End of the range (world time, inclusive)
+     * @param results Receives the messages, oldest first
+     */
+    void QueryTeam(int teamID, float fromTime, float toTime, notnull array<ref TeamChatMessage> results)
+    {
+        foreach (TeamChatLogSegment segment : m_Segments)
+        {
+            if (segment.Overlaps(fromTime, toTime))
+                segment.QueryTeam(teamID, fromTime, toTime, results);
+        }
+    }
+
+    /**
+     * @brief Get the messages of a sender within a time range
+     * @param senderHandle The player handle of the sender
+     * @param fromTime Start of the range (world time, inclusive)
+     * @param toTime End of the range (world time, inclusive)
+     * @param results Receives the messages, oldest first
+     */
+    void QuerySender(int senderHandle, float fromTime, float toTime, notnull array<ref TeamChatMessage> results)
+    {
+        foreach (TeamChatLogSegment segment : m_Segments)
+        {
+            if (segment.Overlaps(fromTime, toTime))
+                segment.QuerySender(senderHandle, fromTime, toTime, results);
+        }
+    }
+
+    /**
+     * @brief Start a new segment, dropping the oldest one from memory when over the limit
+     * @param time World time of the first record
+     * @return The new segment
+     */
+    protected TeamChatLogSegment StartSegment(float time)
+    {
+        TeamChatLogSegment segment = new TeamChatLogSegment(m_SegmentCount, time);
+        m_SegmentCount++;
+
+        m_Segments.Insert(segment);
+        m_WriteQueue.Insert(segment);
+
+        // The write queue keeps its own reference until the segment is on disk
+        if (m_Segments.Count() > MAX_SEGMENTS_IN_MEMORY)
+            m_Segments.RemoveOrdered(0);
+
+        return segment;
+    }
+
+    /**
+     * @brief Write up to a number of records of the oldest queued segment
+     * @param budget Maximum number of records to write
+     * @param final True at shutdown, when the open segment is closed as soon as it is written too
+     */
+    protected void WriteRecords(int budget, bool final = false)
+    {
+        TeamChatLogSegment segment = m_WriteQueue[0];
+
+        if (!m_File)
+        {
+            string path = LOG_DIRECTORY + "/chat_" + m_SessionID + "_" + segment.GetSegmentID() + ".log";
+            m_File = FileIO.OpenFile(path, FileMode.WRITE);
+            if (!m_File)
+            {
+                Print("TeamChatLog: Could not open " + path + ", dropping segment");
+                FinishSegment();
+                return;
+            }
+
+            // Text lines; see FormatHeader and FormatRecord for the layout
+            m_File.WriteLine(segment.FormatHeader());
+            m_WrittenSenders.Clear();
+        }
+
+        int end = Math.Min(m_WrittenRecords + budget, segment.GetRecordCount());
+        for (int record = m_WrittenRecords; record < end; record++)
+        {
+            m_File.WriteLine(segment.FormatRecord(record, m_WrittenSenders));
+        }
+        m_WrittenRecords = end;
+
+        // A segment is done once it is full and everything is written; the open one keeps its file until shutdown
+        bool keepOpen = m_WriteQueue.Count() == 1 && !final;
+        if (m_WrittenRecords >= SEGMENT_RECORDS || (!keepOpen && m_WrittenRecords >= segment.GetRecordCount()))
+            FinishSegment();
+    }
+
+    /**
+     * @brief Close the current file and move on to the next queued segment
+     */
+    protected void FinishSegment()
+    {
+        if (m_File)
+        {
+            m_File.Close();
+            m_File = null;
+        }
+
+        m_WriteQueue.RemoveOrdered(0);
+        m_WrittenRecords = 0;
+    }
+}
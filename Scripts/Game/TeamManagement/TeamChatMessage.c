@@ -1,6 +1,9 @@
 /**
  * @brief Container class for team chat messages
  */
+
+// Import necessary classes from the engine
+#include "../Network/ScriptCallContext.c"
 class TeamChatMessage
 {
     // Team ID this message belongs to
@@ -18,6 +21,9 @@ class TeamChatMessage
     // Timestamp when the message was created
     protected float m_Timestamp;
     
+    // Position in the team's chat as numbered by the server, -1 if not sequenced
+    protected int m_Sequence = -1;
+    
     //------------------------------------------------------------------------------------------------
     /**
      * @brief Constructor
@@ -26,7 +32,7 @@ class TeamChatMessage
      * @param senderName The name of the sender
      * @param messageText The text of the message
      */
-    void TeamChatMessage(int teamID, string senderID, string senderName, string messageText)
+    void TeamChatMessage(int teamID = 0, string senderID = "", string senderName = "", string messageText = "")
     {
         m_TeamID = teamID;
         m_SenderID = senderID;
@@ -85,6 +91,16 @@ class TeamChatMessage
         return m_Timestamp;
     }
     
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Get the sequence number
+     * @return The server-assigned sequence number within the team, -1 if not sequenced
+     */
+    int GetSequence()
+    {
+        return m_Sequence;
+    }
+    
     //------------------------------------------------------------------------------------------------
     /**
      * @brief Check if the message has expired
@@ -99,33 +115,158 @@ class TeamChatMessage
     
     //------------------------------------------------------------------------------------------------
     /**
-     * @brief Format the message for network transmission
-     * @return Formatted string for network transmission
+     * @brief Set the sender name
+     * Used after deserializing, since the wire format carries only the sender handle
+     * @param senderName The name of the sender
+     */
+    void SetSenderName(string senderName)
+    {
+        m_SenderName = senderName;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Overwrite all fields, stamping the message with the current time
+     * Allows one message object to be reused when replaying stored messages.
+     * @param teamID The team ID
+     * @param senderID The ID of the sender
+     * @param senderName The name of the sender
+     * @param messageText The text of the message
+     * @param sequence The sequence number within the team
+     */
+    void Assign(int teamID, string senderID, string senderName, string messageText, int sequence)
+    {
+        m_TeamID = teamID;
+        m_SenderID = senderID;
+        m_SenderName = senderName;
+        m_MessageText = messageText;
+        m_Sequence = sequence;
+        m_Timestamp = GetGame().GetWorld().GetWorldTime();
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Write the message in its binary wire format
+     * Layout: varint team ID, varint sequence, varint sender handle, length-prefixed UTF-8 text.
+     * The sender name is not written; receivers resolve it from the handle.
+     * @param writer The writer to serialize into
+     */
+    void Serialize(ScriptBitWriter writer)
+    {
+        WriteMessage(writer, m_TeamID, Math.Max(m_Sequence, 0), m_SenderID.ToInt(), m_MessageText);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Write a message in the wire format of Serialize without creating a message object
+     * @param writer The writer to serialize into
+     * @param teamID The team ID
+     * @param sequence The sequence number within the team
+     * @param senderHandle The player handle of the sender
+     * @param messageText The text of the message
+     */
+    static void WriteMessage(ScriptBitWriter writer, int teamID, int sequence, int senderHandle, string messageText)
+    {
+        WriteVarInt(writer, teamID);
+        WriteVarInt(writer, sequence);
+        WriteVarInt(writer, senderHandle);
+        writer.WriteUtf8String(messageText);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Read a message written by Serialize into this object
+     * Allows one message object to be reused for a whole batch.
+     * @param reader The reader to deserialize from
+     */
+    void Deserialize(ScriptBitReader reader)
+    {
+        m_TeamID = ReadVarInt(reader);
+        m_Sequence = ReadVarInt(reader);
+        m_SenderID = ReadVarInt(reader).ToString();
+        m_SenderName = "";
+        m_MessageText = reader.ReadUtf8String();
+        m_Timestamp = GetGame().GetWorld().GetWorldTime();
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Write one message of a chat batch
+     * Layout: varint sequence, sender index in the batch's sender table using only the bits the
+     * table needs, length-prefixed UTF-8 text. The team ID is part of the batch header.
+     * @param writer The writer to serialize into
+     * @param sequence The sequence number within the team
+     * @param sender The index of the sender in the batch's sender table
+     * @param senderCount The number of entries in the sender table
+     * @param messageText The text of the message
      */
-    string FormatForNetwork()
+    static void WriteBatchMessage(ScriptBitWriter writer, int sequence, int sender, int senderCount, string messageText)
     {
-        return string.Format("%1|%2|%3|%4", m_TeamID.ToString(), m_SenderID, m_SenderName, m_MessageText);
+        WriteVarInt(writer, sequence);
+        writer.WriteIntRange(sender, 0, senderCount - 1);
+        writer.WriteUtf8String(messageText);
     }
     
     //------------------------------------------------------------------------------------------------
     /**
-     * @brief Create a message from network-formatted string
-     * @param formattedString The formatted string
-     * @return New TeamChatMessage object, or null if parsing failed
+     * @brief Read a message written by WriteBatchMessage into this object
+     * @param reader The reader to deserialize from
+     * @param teamID The team ID from the batch header
+     * @param senderHandles Player handles of the batch's sender table
+     * @param senderNames Names of the batch's sender table
+     * @return False if the sender index lies outside the table
      */
-    static TeamChatMessage CreateFromNetworkString(string formattedString)
+    bool DeserializeBatchMessage(ScriptBitReader reader, int teamID, notnull array<int> senderHandles, notnull array<string> senderNames)
     {
-        array<string> parts = new array<string>();
-        formattedString.Split("|", parts);
+        m_TeamID = teamID;
+        m_Sequence = ReadVarInt(reader);
+        int sender = reader.ReadIntRange(0, senderHandles.Count() - 1);
+        m_MessageText = reader.ReadUtf8String();
+        m_Timestamp = GetGame().GetWorld().GetWorldTime();
         
-        if (parts.Count() < 4)
-            return null;
-            
-        int teamID = parts[0].ToInt();
-        string senderID = parts[1];
-        string senderName = parts[2];
-        string messageText = parts[3];
+        if (sender >= senderHandles.Count())
+            return false;
+        
+        m_SenderID = senderHandles[sender].ToString();
+        m_SenderName = senderNames[sender];
+        return true;
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Write a non-negative integer in 7-bit groups, low group first
+     * Small values such as team IDs and player handles take one or two bytes instead of four.
+     * @param writer The writer to serialize into
+     * @param value The value to write
+     */
+    static void WriteVarInt(ScriptBitWriter writer, int value)
+    {
+        while ((value & ~0x7F) != 0)
+        {
+            writer.WriteIntRange((value & 0x7F) | 0x80, 0, 255);
+            value = (value >> 7) & 0x1FFFFFF; // Logical shift so the loop ends
+        }
+        
+        writer.WriteIntRange(value, 0, 255);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief Read an integer written by WriteVarInt
+     * @param reader The reader to deserialize from
+     * @return The read value
+     */
+    static int ReadVarInt(ScriptBitReader reader)
+    {
+        int value = 0;
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+            int group = reader.ReadIntRange(0, 255);
+            value |= (group & 0x7F) << shift;
+            if ((group & 0x80) == 0)
+                break;
+        }
         
-        return new TeamChatMessage(teamID, senderID, senderName, messageText);
+        return value;
     }
 }
\ No newline at end of file
@@ -0,0 +1,225 @@
+/**
+ * @brief Server-side flood protection for team chat
+ *
+ * Every sender owns a token bucket that holds up to ChatBurst tokens and refills at
+ * ChatMessagesPerSecond. Each accepted message costs one token, so the chat traffic a
+ * server forwards is bounded per player regardless of what clients send. Messages are
+ * truncated to MaxMessageLength, and a sender repeating their previous message within
+ * ChatDuplicateWindow seconds is dropped. Drop counters are kept per reason for tuning.
+ * Team pings draw from the same bucket, so chat and pings together stay within the limit.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+#include "TeamManagementSettings.c"
+
+enum ETeamChatDropReason
+{
+    NONE,
+    EMPTY,
+    RATE_LIMITED,
+    DUPLICATE
+}
+
+class TeamChatRateLimiter
+{
+    // Sender record index by player handle
+    protected ref map<int, int> m_SenderIndex = new map<int, int>();
+
+    // Per sender record: tokens left, time of the last refill, last accepted message and its time
+    protected ref array<float> m_Tokens = new array<float>();
+    protected ref array<float> m_LastRefillTimes = new array<float>();
+    protected ref array<string> m_LastMessages = new array<string>();
+    protected ref array<float> m_LastMessageTimes = new array<float>();
+
+    // Stack of released sender records, valid up to m_FreeRecordCount
+    protected ref array<int> m_FreeRecords = new array<int>();
+    protected int m_FreeRecordCount = 0;
+
+    // Dropped messages per ETeamChatDropReason
+    protected ref array<int> m_DropCounts = {0, 0, 0, 0};
+
+    // Accepted messages, and accepted messages that had to be truncated
+    protected int m_AcceptedCount = 0;
+    protected int m_TruncatedCount = 0;
+
+    /**
+     * @brief Check a message against the sender's limits and consume a token if accepted
+     * @param senderHandle The player handle of the sender
+     * @param messageText The message text; trimmed and truncated in place to the maximum length
+     * @param currentTime Current world time
+     * @return NONE if the message may be forwarded, otherwise the reason it was dropped
+     */
+    ETeamChatDropReason Check(int senderHandle, inout string messageText, float currentTime)
+    {
+        TeamManagementSettings settings = TeamManagementSettings.Get();
+
+        messageText = messageText.Trim();
+        if (messageText.IsEmpty())
+            return Drop(ETeamChatDropReason.EMPTY);
+
+        if (messageText.Length() > settings.m_MaxMessageLength)
+        {
+            messageText = messageText.Substring(0, settings.m_MaxMessageLength);
+            m_TruncatedCount++;
+        }
+
+        int record = GetRecord(senderHandle, currentTime);
+        if (!Refill(record, currentTime))
+            return Drop(ETeamChatDropReason.RATE_LIMITED);
+
+        if (m_LastMessages[record] == messageText && currentTime - m_LastMessageTimes[record] < settings.m_ChatDuplicateWindow)
+            return Drop(ETeamChatDropReason.DUPLICATE);
+
+        m_Tokens[record] = m_Tokens[record] - 1.0;
+        m_LastMessages[record] = messageText;
+        m_LastMessageTimes[record] = currentTime;
+        m_AcceptedCount++;
+
+        return ETeamChatDropReason.NONE;
+    }
+
+    /**
+     * @brief Consume a token for a team ping
+     * @param senderHandle The player handle of the sender
+     * @param currentTime Current world time
+     * @return True if the ping may be forwarded
+     */
+    bool CheckPing(int senderHandle, float currentTime)
+    {
+        int record = GetRecord(senderHandle, currentTime);
+        if (!Refill(record, currentTime))
+        {
+            Drop(ETeamChatDropReason.RATE_LIMITED);
+            return false;
+        }
+
+        m_Tokens[record] = m_Tokens[record] - 1.0;
+        m_AcceptedCount++;
+        return true;
+    }
+
+    /**
+     * @brief Forget a sender, e.g. when the player disconnects
+     * @param senderHandle The player handle of the sender
+     */
+    void RemoveSender(int senderHandle)
+    {
+        int record;
+        if (!m_SenderIndex.Find(senderHandle, record))
+            return;
+
+        m_SenderIndex.Remove(senderHandle);
+        m_LastMessages[record] = "";
+
+        if (m_FreeRecordCount < m_FreeRecords.Count())
+            m_FreeRecords[m_FreeRecordCount] = record;
+        else
+            m_FreeRecords.Insert(record);
+        m_FreeRecordCount++;
+    }
+
+    /**
+     * @brief Get the number of dropped messages for a reason
+     * @param reason The drop reason
+     * @return The drop count since the last reset
+     */
+    int GetDropCount(ETeamChatDropReason reason)
+    {
+        return m_DropCounts[reason];
+    }
+
+    /**
+     * @brief Get the number of accepted messages
+     * @return The accepted count since the last reset
+     */
+    int GetAcceptedCount()
+    {
+        return m_AcceptedCount;
+    }
+
+    /**
+     * @brief Get the number of accepted messages that were truncated
+     * @return The truncated count since the last reset
+     */
+    int GetTruncatedCount()
+    {
+        return m_TruncatedCount;
+    }
+
+    /**
+     * @brief Reset all counters
+     */
+    void ResetCounters()
+    {
+        for (int i = 0; i < m_DropCounts.Count(); i++)
+        {
+            m_DropCounts[i] = 0;
+        }
+
+        m_AcceptedCount = 0;
+        m_TruncatedCount = 0;
+    }
+
+    /**
+     * @brief Get the record of a sender, creating it with a full bucket if needed
+     * @param senderHandle The player handle of the sender
+     * @param currentTime Current world time
+     * @return The record index
+     */
+    protected int GetRecord(int senderHandle, float currentTime)
+    {
+        int record;
+        if (m_SenderIndex.Find(senderHandle, record))
+            return record;
+
+        if (m_FreeRecordCount > 0)
+        {
+            m_FreeRecordCount--;
+            record = m_FreeRecords[m_FreeRecordCount];
+        }
+        else
+        {
+            record = m_Tokens.Count();
+            m_Tokens.Insert(0);
+            m_LastRefillTimes.Insert(0);
+            m_LastMessages.Insert("");
+            m_LastMessageTimes.Insert(0);
+        }
+
+        m_Tokens[record] = TeamManagementSettings.Get().m_ChatBurst;
+        m_LastRefillTimes[record] = currentTime;
+        m_LastMessages[record] = "";
+        m_LastMessageTimes[record] = 0;
+        m_SenderIndex.Set(senderHandle, record);
+
+        return record;
+    }
+
+    /**
+     * @brief Refill a sender's bucket for the time since the last refill
+     * @param record The record index
+     * @param currentTime Current world time
+     * @return True if at least one token is available
+     */
+    protected bool Refill(int record, float currentTime)
+    {
+        TeamManagementSettings settings = TeamManagementSettings.Get();
+        float tokens = m_Tokens[record] + (currentTime - m_LastRefillTimes[record]) * settings.m_ChatMessagesPerSecond;
+        m_Tokens[record] = Math.Min(tokens, settings.m_ChatBurst);
+        m_LastRefillTimes[record] = currentTime;
+
+        return m_Tokens[record] >= 1.0;
+    }
+
+    /**
+     * @brief Count a dropped message
+     * @param reason The drop reason
+     * @return The drop reason
+     */
+    protected ETeamChatDropReason Drop(ETeamChatDropReason reason)
+    {
+        m_DropCounts[reason] = m_DropCounts[reason] + 1;
+        return reason;
+    }
+}
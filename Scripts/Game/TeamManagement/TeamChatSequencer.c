@@ -0,0 +1,184 @@
+/**
+ * @brief Client-side ordering and deduplication of sequenced team chat
+ *
+ * The server numbers each team's chat messages consecutively. The sequencer remembers the
+ * next number it expects: an older or already seen number is a duplicate, the expected one
+ * is shown at once, and a later one waits in a small window until the gap before it fills.
+ * The window is indexed by sequence number modulo its size, so stashing and releasing a
+ * message is O(1) and the window storage is allocated once.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+#include "TeamChatMessage.c"
+class TeamChatSequencer
+{
+    // Number of messages that can wait for a gap to fill
+    static const int WINDOW_SIZE = 16;
+
+    // Sequence number expected next, -1 until the first message arrives
+    protected int m_NextSequence = -1;
+
+    // Per window slot: whether it holds a message, and the message fields
+    protected ref array<bool> m_Pending = new array<bool>();
+    protected ref array<int> m_TeamIDs = new array<int>();
+    protected ref array<string> m_SenderIDs = new array<string>();
+    protected ref array<string> m_SenderNames = new array<string>();
+    protected ref array<string> m_Texts = new array<string>();
+
+    // Number of occupied window slots
+    protected int m_PendingCount = 0;
+
+    // Messages dropped as duplicates
+    protected int m_DuplicateCount = 0;
+
+    /**
+     * @brief Constructor
+     */
+    void TeamChatSequencer()
+    {
+        m_Pending.Resize(WINDOW_SIZE);
+        m_TeamIDs.Resize(WINDOW_SIZE);
+        m_SenderIDs.Resize(WINDOW_SIZE);
+        m_SenderNames.Resize(WINDOW_SIZE);
+        m_Texts.Resize(WINDOW_SIZE);
+
+        for (int slot = 0; slot < WINDOW_SIZE; slot++)
+        {
+            m_Pending[slot] = false;
+        }
+    }
+
+    /**
+     * @brief Forget all state, e.g. when the player changes team
+     * The next message received starts a new sequence.
+     */
+    void Reset()
+    {
+        for (int slot = 0; slot < WINDOW_SIZE; slot++)
+        {
+            ReleaseSlot(slot);
+        }
+
+        m_NextSequence = -1;
+    }
+
+    /**
+     * @brief Offer a received message
+     * Messages that are not shown at once are either stashed in the window or dropped as duplicates.
+     * @param message The received message
+     * @return True if the message is the next in order and should be shown now
+     */
+    bool Offer(TeamChatMessage message)
+    {
+        int sequence = message.GetSequence();
+
+        // First message, or a jump the window cannot bridge with nothing waiting
+        if (m_NextSequence < 0 || (IsBeyondWindow(sequence) && m_PendingCount == 0))
+        {
+            m_NextSequence = sequence + 1;
+            return true;
+        }
+
+        if (sequence < m_NextSequence)
+        {
+            m_DuplicateCount++;
+            return false;
+        }
+
+        if (sequence == m_NextSequence)
+        {
+            m_NextSequence++;
+            return true;
+        }
+
+        int slot = sequence % WINDOW_SIZE;
+        if (m_Pending[slot])
+        {
+            m_DuplicateCount++;
+            return false;
+        }
+
+        m_Pending[slot] = true;
+        m_TeamIDs[slot] = message.GetTeamID();
+        m_SenderIDs[slot] = message.GetSenderID();
+        m_SenderNames[slot] = message.GetSenderName();
+        m_Texts[slot] = message.GetMessageText();
+        m_PendingCount++;
+        return false;
+    }
+
+    /**
+     * @brief Take the next stashed message that may be shown
+     * @param message Receives the message
+     * @param skipGaps If true, missing messages before the next stashed one are given up on
+     * @return True if a message was written to the message object
+     */
+    bool PopPending(notnull TeamChatMessage message, bool skipGaps)
+    {
+        if (m_PendingCount == 0)
+            return false;
+
+        for (int offset = 0; offset < WINDOW_SIZE; offset++)
+        {
+            int sequence = m_NextSequence + offset;
+            int slot = sequence % WINDOW_SIZE;
+            if (m_Pending[slot])
+            {
+                message.Assign(m_TeamIDs[slot], m_SenderIDs[slot], m_SenderNames[slot], m_Texts[slot], sequence);
+                ReleaseSlot(slot);
+                m_NextSequence = sequence + 1;
+                return true;
+            }
+
+            if (!skipGaps)
+                return false;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Check if a sequence number is too far ahead to be stashed
+     * @param sequence The sequence number
+     * @return True if the window cannot hold it
+     */
+    bool IsBeyondWindow(int sequence)
+    {
+        return m_NextSequence >= 0 && sequence - m_NextSequence >= WINDOW_SIZE;
+    }
+
+    /**
+     * @brief Check if messages are waiting for a gap to fill
+     * @return True if the window is not empty
+     */
+    bool HasPending()
+    {
+        return m_PendingCount > 0;
+    }
+
+    /**
+     * @brief Get the number of messages dropped as duplicates
+     * @return The duplicate count
+     */
+    int GetDuplicateCount()
+    {
+        return m_DuplicateCount;
+    }
+
+    /**
+     * @brief Empty a window slot
+     * @param slot The slot index
+     */
+    protected void ReleaseSlot(int slot)
+    {
+        if (!m_Pending[slot])
+            return;
+
+        m_Pending[slot] = false;
+        m_SenderIDs[slot] = "";
+        m_SenderNames[slot] = "";
+        m_Texts[slot] = "";
+        m_PendingCount--;
+    }
+}
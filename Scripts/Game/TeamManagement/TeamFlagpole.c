@@ -9,6 +9,7 @@
 #include "../Core/IEntity.c"
 #include "../Core/Game.c"
 #include "TeamRespawnComponent.c"
+#include "TeamFlagpoleGrid.c"
 #include "../Core/EntityID.c"
 #include "../TeamManagement/TeamNetworkComponent.c" // Use our custom RPC implementation
 class TeamFlagpole : GenericEntity
@@ -23,11 +24,20 @@ class TeamFlagpole : GenericEntity
         SetEventMask(EntityEvent.INIT | EntityEvent.FRAME);
     }
     
+    //------------------------------------------------------------------------------------------------
+    void ~TeamFlagpole()
+    {
+        TeamFlagpoleGrid.GetInstance().Remove(GetID().GetValue());
+    }
+    
     //------------------------------------------------------------------------------------------------
     override void EOnInit(IEntity owner)
     {
         super.EOnInit(owner);
         
+        // Make this flagpole known to placement checks
+        TeamFlagpoleGrid.GetInstance().Add(GetID().GetValue(), GetOrigin());
+        
         // Add respawn component
         TeamRespawnComponent respComp = TeamRespawnComponent.Cast(FindComponent(TeamRespawnComponent));
         if (!respComp)
@@ -117,7 +127,7 @@ class TeamFlagpole : GenericEntity
             int teamID = playerMember.GetTeamID();
             
             // Check if team already has maximum number of flagpoles
-            if (teamManager.GetTeamFlagpoleCount(teamID) >= TeamManager.MAX_FLAGPOLES_PER_TEAM)
+            if (teamManager.GetTeamFlagpoleCount(teamID) >= TeamManagementSettings.Get().m_MaxFlagpolesPerTeam)
             {
                 // Notify player
                 PlayerController pc = PlayerController.Cast(playerEntity.GetController());
@@ -129,7 +139,7 @@ class TeamFlagpole : GenericEntity
             }
             
             // Check if this location is valid (not too close to other flagpoles)
-            if (!TeamRespawnComponent.CanPlaceFlagpoleAt(GetOrigin()))
+            if (!TeamRespawnComponent.CanPlaceFlagpoleAt(GetOrigin(), this))
             {
                 // Notify player
                 PlayerController pc = PlayerController.Cast(playerEntity.GetController());
@@ -144,10 +154,9 @@ class TeamFlagpole : GenericEntity
             TeamRespawnComponent respComp = GetRespawnComponent();
             if (respComp)
             {
-                respComp.AssignTeam(teamID, playerID, customName);
-                
-                // Register flagpole with the team manager
-                teamManager.RegisterFlagpole(teamID, this);
+                // Also registers the flagpole as a respawn point of the team
+                if (!respComp.AssignTeam(teamID, playerID, customName))
+                    return false;
                 
                 // Notify player
                 PlayerController pc = PlayerController.Cast(playerEntity.GetController());
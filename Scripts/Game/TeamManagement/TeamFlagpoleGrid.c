@@ -0,0 +1,198 @@
+/**
+ * @brief Uniform grid of flagpole positions for placement checks
+ *
+ * Flagpoles add themselves when initialized and remove themselves when deleted. The cell
+ * size equals MinFlagpoleDistance, so every flagpole closer than that to a position lies in
+ * the 3x3 cells around it: a placement check looks at those cells only and compares squared
+ * distances, whatever the number of flagpoles on the map.
+ *
+ * Cells are keyed by their two coordinates packed into one int (16 bits each, so the grid
+ * repeats every 65536 cells, far beyond any map) and hold flagpole entity IDs.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+#include "TeamManagementSettings.c"
+class TeamFlagpoleGrid
+{
+    // Singleton instance
+    private static ref TeamFlagpoleGrid s_Instance;
+
+    // Flagpole entity IDs per cell key
+    protected ref map<int, ref array<int>> m_Cells = new map<int, ref array<int>>();
+
+    // Position of each flagpole by entity ID
+    protected ref map<int, vector> m_Positions = new map<int, vector>();
+
+    // Cell size the grid was built with; the grid is rebuilt if MinFlagpoleDistance changes
+    protected float m_CellSize = 0;
+
+    /**
+     * @brief Get the singleton instance
+     * @return The grid
+     */
+    static TeamFlagpoleGrid GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new TeamFlagpoleGrid();
+
+        return s_Instance;
+    }
+
+    /**
+     * @brief Add a flagpole, or move it if it is already in the grid
+     * @param flagpoleID The flagpole entity ID
+     * @param position The flagpole position
+     */
+    void Add(int flagpoleID, vector position)
+    {
+        Remove(flagpoleID);
+        EnsureCellSize();
+
+        m_Positions.Set(flagpoleID, position);
+        InsertIntoCell(flagpoleID, position);
+    }
+
+    /**
+     * @brief Remove a flagpole
+     * @param flagpoleID The flagpole entity ID
+     */
+    void Remove(int flagpoleID)
+    {
+        vector position;
+        if (!m_Positions.Find(flagpoleID, position))
+            return;
+
+        m_Positions.Remove(flagpoleID);
+
+        int key = GetCellKey(position);
+        array<int> cell;
+        if (!m_Cells.Find(key, cell))
+            return;
+
+        int index = cell.Find(flagpoleID);
+        if (index < 0)
+            return;
+
+        // Order within a cell does not matter
+        int last = cell.Count() - 1;
+        cell[index] = cell[last];
+        cell.Remove(last);
+
+        if (cell.Count() == 0)
+            m_Cells.Remove(key);
+    }
+
+    /**
+     * @brief Check if a flagpole other than the ignored one is closer than MinFlagpoleDistance to a position
+     * @param position The position to check
+     * @param ignoreFlagpoleID Entity ID of a flagpole to skip, e.g. the one being placed; 0 for none
+     * @return True if a flagpole is too close
+     */
+    bool HasFlagpoleNear(vector position, int ignoreFlagpoleID = 0)
+    {
+        TeamManagementSettings settings = TeamManagementSettings.Get();
+        if (settings.m_MinFlagpoleDistance <= 0 || m_Positions.Count() == 0)
+            return false;
+
+        EnsureCellSize();
+
+        int cellX = GetCellCoordinate(position[0]);
+        int cellZ = GetCellCoordinate(position[2]);
+        for (int offsetX = -1; offsetX <= 1; offsetX++)
+        {
+            for (int offsetZ = -1; offsetZ <= 1; offsetZ++)
+            {
+                array<int> cell;
+                if (!m_Cells.Find(MakeCellKey(cellX + offsetX, cellZ + offsetZ), cell))
+                    continue;
+
+                foreach (int flagpoleID : cell)
+                {
+                    if (flagpoleID == ignoreFlagpoleID)
+                        continue;
+
+                    if (vector.DistanceSq(position, m_Positions.Get(flagpoleID)) < settings.m_MinFlagpoleDistanceSq)
+                        return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Get the number of flagpoles in the grid
+     * @return The flagpole count
+     */
+    int GetCount()
+    {
+        return m_Positions.Count();
+    }
+
+    /**
+     * @brief Rebuild the cells if MinFlagpoleDistance differs from the current cell size
+     */
+    protected void EnsureCellSize()
+    {
+        float cellSize = Math.Max(TeamManagementSettings.Get().m_MinFlagpoleDistance, 1.0);
+        if (cellSize == m_CellSize)
+            return;
+
+        m_CellSize = cellSize;
+        m_Cells.Clear();
+        foreach (int flagpoleID, vector position : m_Positions)
+        {
+            InsertIntoCell(flagpoleID, position);
+        }
+    }
+
+    /**
+     * @brief Add a flagpole to the cell containing its position
+     * @param flagpoleID The flagpole entity ID
+     * @param position The flagpole position
+     */
+    protected void InsertIntoCell(int flagpoleID, vector position)
+    {
+        int key = GetCellKey(position);
+        array<int> cell;
+        if (!m_Cells.Find(key, cell))
+        {
+            cell = new array<int>();
+            m_Cells.Set(key, cell);
+        }
+
+        cell.Insert(flagpoleID);
+    }
+
+    /**
+     * @brief Get the key of the cell containing a position
+     * @param position The world position
+     * @return The cell key
+     */
+    protected int GetCellKey(vector position)
+    {
+        return MakeCellKey(GetCellCoordinate(position[0]), GetCellCoordinate(position[2]));
+    }
+
+    /**
+     * @brief Get the cell coordinate of a world coordinate
+     * @param coordinate The world X or Z coordinate
+     * @return The cell coordinate
+     */
+    protected int GetCellCoordinate(float coordinate)
+    {
+        return Math.Floor(coordinate / m_CellSize);
+    }
+
+    /**
+     * @brief Pack two cell coordinates into a cell key
+     * @param cellX The cell X coordinate
+     * @param cellZ The cell Z coordinate
+     * @return The cell key
+     */
+    protected int MakeCellKey(int cellX, int cellZ)
+    {
+        return ((cellX & 0xFFFF) << 16) | (cellZ & 0xFFFF);
+    }
+}
@@ -197,7 +197,7 @@ class TeamManagementMenu
             Print("Team created with ID: " + teamID);
             
             // Notify player
-            SCR_NotificationSystem.SendNotification("Team created. Team ID: " + teamID);
+            SCR_NotificationSystem.SendNotification("Team created. Team ID: " + TeamManager.GetTeamDisplayNumber(teamID));
             
             // Update UI
             UpdateUI();
@@ -0,0 +1,290 @@
+/**
+ * @brief Server-configurable limits of the team management system
+ *
+ * Settings are read once from a key=value file when the world module initializes on the
+ * authority and are not modified afterwards. Clients never read the file: the server sends
+ * them the limits their own checks and UI use when they connect, and everything else keeps
+ * its default on clients. Hot paths read the plain fields directly; values that are only
+ * ever compared in derived form (e.g. squared distances) are precomputed at load.
+ *
+ * Example TeamManagement.cfg in the server profile folder:
+ *   // Team limits
+ *   MaxTeamSize=6
+ *   RespawnCooldownSeconds=120
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+#include "../Network/ScriptCallContext.c"
+#include "TeamRoster.c"
+class TeamManagementSettings
+{
+    // Default settings file in the profile folder
+    static const string DEFAULT_PATH = "$profile:TeamManagement.cfg";
+
+    // Default values, used for missing keys and for specialized fast paths
+    static const int DEFAULT_MAX_TEAM_SIZE = 8;
+    static const int DEFAULT_MAX_FLAGPOLES_PER_TEAM = 1;
+    static const float DEFAULT_RESPAWN_COOLDOWN_SECONDS = 300.0;
+    static const float DEFAULT_MIN_FLAGPOLE_DISTANCE = 100.0;
+    static const int DEFAULT_PURCHASE_COST = 9999;
+    static const float DEFAULT_INVITATION_CLEANUP_INTERVAL = 30.0;
+    static const float DEFAULT_NETWORK_SYNC_INTERVAL = 10.0;
+    static const int DEFAULT_MAX_CHAT_HISTORY = 50;
+    static const int DEFAULT_MAX_MESSAGE_LENGTH = 128;
+    static const float DEFAULT_CHAT_BURST = 5.0;
+    static const float DEFAULT_CHAT_MESSAGES_PER_SECOND = 1.0;
+    static const float DEFAULT_CHAT_DUPLICATE_WINDOW = 10.0;
+    static const bool DEFAULT_CHAT_LOG_ENABLED = true;
+    static const float DEFAULT_CHAT_FILTER_RELOAD_INTERVAL = 60.0;
+    static const float DEFAULT_VEHICLE_LOCK_IDLE_SECONDS = 1800.0;
+    static const float DEFAULT_VEHICLE_LOCK_PROXIMITY = 50.0;
+
+    // The active settings
+    private static ref TeamManagementSettings s_Instance;
+
+    // Maximum number of players in a team (at most TeamRoster.MEMBER_STRIDE)
+    int m_MaxTeamSize = DEFAULT_MAX_TEAM_SIZE;
+
+    // Maximum number of flagpoles a team may own
+    int m_MaxFlagpolesPerTeam = DEFAULT_MAX_FLAGPOLES_PER_TEAM;
+
+    // Cooldown in seconds between respawns at a flagpole
+    float m_RespawnCooldownSeconds = DEFAULT_RESPAWN_COOLDOWN_SECONDS;
+
+    // Minimum distance between flagpoles in meters, and its square for distance checks
+    float m_MinFlagpoleDistance = DEFAULT_MIN_FLAGPOLE_DISTANCE;
+    float m_MinFlagpoleDistanceSq = DEFAULT_MIN_FLAGPOLE_DISTANCE * DEFAULT_MIN_FLAGPOLE_DISTANCE;
+
+    // Cost to purchase a flagpole
+    int m_PurchaseCost = DEFAULT_PURCHASE_COST;
+
+    // Seconds between cleaning up expired invitations
+    float m_InvitationCleanupInterval = DEFAULT_INVITATION_CLEANUP_INTERVAL;
+
+    // Seconds between periodic network synchronizations
+    float m_NetworkSyncInterval = DEFAULT_NETWORK_SYNC_INTERVAL;
+
+    // Number of chat messages kept per player
+    int m_MaxChatHistory = DEFAULT_MAX_CHAT_HISTORY;
+
+    // Maximum character length of a chat message, enforced by the server
+    int m_MaxMessageLength = DEFAULT_MAX_MESSAGE_LENGTH;
+
+    // Chat messages a player may send in a burst, and the sustained rate they refill at
+    float m_ChatBurst = DEFAULT_CHAT_BURST;
+    float m_ChatMessagesPerSecond = DEFAULT_CHAT_MESSAGES_PER_SECOND;
+
+    // Seconds during which repeating the previous message is dropped
+    float m_ChatDuplicateWindow = DEFAULT_CHAT_DUPLICATE_WINDOW;
+
+    // Whether the server keeps a team chat log for moderation
+    bool m_ChatLogEnabled = DEFAULT_CHAT_LOG_ENABLED;
+
+    // Seconds between checks of the chat filter word list for changes, 0 to load it only at startup
+    float m_ChatFilterReloadInterval = DEFAULT_CHAT_FILTER_RELOAD_INTERVAL;
+
+    // Seconds a locked vehicle may go unused by its team before it is unlocked, 0 to keep locks forever
+    float m_VehicleLockIdleSeconds = DEFAULT_VEHICLE_LOCK_IDLE_SECONDS;
+
+    // Distance in meters within which a team member counts as using a locked vehicle, and its square
+    float m_VehicleLockProximity = DEFAULT_VEHICLE_LOCK_PROXIMITY;
+    float m_VehicleLockProximitySq = DEFAULT_VEHICLE_LOCK_PROXIMITY * DEFAULT_VEHICLE_LOCK_PROXIMITY;
+
+    // True when every limit has its default value
+    bool m_IsDefault = true;
+
+    /**
+     * @brief Get the active settings
+     * Falls back to defaults if nothing was loaded yet.
+     * @return The settings instance
+     */
+    static TeamManagementSettings Get()
+    {
+        if (!s_Instance)
+            s_Instance = new TeamManagementSettings();
+
+        return s_Instance;
+    }
+
+    /**
+     * @brief Load the settings from a file and make them the active settings
+     * Missing files or keys keep their defaults; invalid values are clamped.
+     * @param path The settings file path
+     * @return The loaded settings
+     */
+    static TeamManagementSettings Load(string path = DEFAULT_PATH)
+    {
+        TeamManagementSettings settings = new TeamManagementSettings();
+
+        FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+        if (file)
+        {
+            string line;
+            while (file.ReadLine(line) >= 0)
+            {
+                settings.ParseLine(line);
+            }
+
+            file.Close();
+            Print("TeamManagementSettings: Loaded " + path);
+        }
+        else
+        {
+            Print("TeamManagementSettings: " + path + " not found, using defaults");
+        }
+
+        settings.Finalize();
+        s_Instance = settings;
+        return settings;
+    }
+
+    /**
+     * @brief Write the limits clients use for their own checks and UI
+     * @param ctx The RPC context to write to
+     */
+    void SerializeReplicated(ScriptCallContext ctx)
+    {
+        ctx.WriteInt(m_MaxTeamSize);
+        ctx.WriteInt(m_MaxFlagpolesPerTeam);
+        ctx.WriteFloat(m_RespawnCooldownSeconds);
+        ctx.WriteFloat(m_MinFlagpoleDistance);
+        ctx.WriteInt(m_PurchaseCost);
+        ctx.WriteInt(m_MaxMessageLength);
+    }
+
+    /**
+     * @brief Apply the limits written by SerializeReplicated to the active settings
+     * The active instance is updated in place, so references held elsewhere stay current.
+     * @param ctx The RPC context to read from
+     */
+    static void DeserializeReplicated(ScriptCallContext ctx)
+    {
+        TeamManagementSettings settings = Get();
+        settings.m_MaxTeamSize = ctx.ReadInt();
+        settings.m_MaxFlagpolesPerTeam = ctx.ReadInt();
+        settings.m_RespawnCooldownSeconds = ctx.ReadFloat();
+        settings.m_MinFlagpoleDistance = ctx.ReadFloat();
+        settings.m_PurchaseCost = ctx.ReadInt();
+        settings.m_MaxMessageLength = ctx.ReadInt();
+        settings.Finalize();
+    }
+
+    /**
+     * @brief Apply one key=value line
+     * @param line The line to parse
+     */
+    protected void ParseLine(string line)
+    {
+        line = line.Trim();
+        if (line.IsEmpty() || line.IndexOf("//") == 0)
+            return;
+
+        int separator = line.IndexOf("=");
+        if (separator <= 0)
+            return;
+
+        string key = line.Substring(0, separator);
+        string value = line.Substring(separator + 1, line.Length() - separator - 1);
+        key = key.Trim();
+        value = value.Trim();
+
+        switch (key)
+        {
+            case "MaxTeamSize":
+                m_MaxTeamSize = value.ToInt();
+                break;
+            case "MaxFlagpolesPerTeam":
+                m_MaxFlagpolesPerTeam = value.ToInt();
+                break;
+            case "RespawnCooldownSeconds":
+                m_RespawnCooldownSeconds = value.ToFloat();
+                break;
+            case "MinFlagpoleDistance":
+                m_MinFlagpoleDistance = value.ToFloat();
+                break;
+            case "PurchaseCost":
+                m_PurchaseCost = value.ToInt();
+                break;
+            case "InvitationCleanupInterval":
+                m_InvitationCleanupInterval = value.ToFloat();
+                break;
+            case "NetworkSyncInterval":
+                m_NetworkSyncInterval = value.ToFloat();
+                break;
+            case "MaxChatHistory":
+                m_MaxChatHistory = value.ToInt();
+                break;
+            case "MaxMessageLength":
+                m_MaxMessageLength = value.ToInt();
+                break;
+            case "ChatBurst":
+                m_ChatBurst = value.ToFloat();
+                break;
+            case "ChatMessagesPerSecond":
+                m_ChatMessagesPerSecond = value.ToFloat();
+                break;
+            case "ChatDuplicateWindow":
+                m_ChatDuplicateWindow = value.ToFloat();
+                break;
+            case "ChatLogEnabled":
+                m_ChatLogEnabled = value.ToInt() != 0;
+                break;
+            case "ChatFilterReloadInterval":
+                m_ChatFilterReloadInterval = value.ToFloat();
+                break;
+            case "VehicleLockIdleSeconds":
+                m_VehicleLockIdleSeconds = value.ToFloat();
+                break;
+            case "VehicleLockProximity":
+                m_VehicleLockProximity = value.ToFloat();
+                break;
+            default:
+                Print("TeamManagementSettings: Unknown key " + key);
+                break;
+        }
+    }
+
+    /**
+     * @brief Clamp values to supported ranges and compute derived fields
+     */
+    protected void Finalize()
+    {
+        // Rosters reserve a fixed block per team, so teams cannot outgrow it
+        m_MaxTeamSize = Math.Clamp(m_MaxTeamSize, 1, TeamRoster.MEMBER_STRIDE);
+        m_MaxFlagpolesPerTeam = Math.Max(m_MaxFlagpolesPerTeam, 0);
+        m_RespawnCooldownSeconds = Math.Max(m_RespawnCooldownSeconds, 0.0);
+        m_MinFlagpoleDistance = Math.Max(m_MinFlagpoleDistance, 0.0);
+        m_PurchaseCost = Math.Max(m_PurchaseCost, 0);
+        m_InvitationCleanupInterval = Math.Max(m_InvitationCleanupInterval, 1.0);
+        m_NetworkSyncInterval = Math.Max(m_NetworkSyncInterval, 1.0);
+        m_MaxChatHistory = Math.Clamp(m_MaxChatHistory, 1, 1000);
+        m_MaxMessageLength = Math.Clamp(m_MaxMessageLength, 1, 1024);
+        m_ChatBurst = Math.Max(m_ChatBurst, 1.0);
+        m_ChatMessagesPerSecond = Math.Max(m_ChatMessagesPerSecond, 0.01);
+        m_ChatDuplicateWindow = Math.Max(m_ChatDuplicateWindow, 0.0);
+        m_ChatFilterReloadInterval = Math.Max(m_ChatFilterReloadInterval, 0.0);
+        m_VehicleLockIdleSeconds = Math.Max(m_VehicleLockIdleSeconds, 0.0);
+        m_VehicleLockProximity = Math.Max(m_VehicleLockProximity, 0.0);
+
+        m_MinFlagpoleDistanceSq = m_MinFlagpoleDistance * m_MinFlagpoleDistance;
+        m_VehicleLockProximitySq = m_VehicleLockProximity * m_VehicleLockProximity;
+
+        m_IsDefault = m_MaxTeamSize == DEFAULT_MAX_TEAM_SIZE
+            && m_MaxFlagpolesPerTeam == DEFAULT_MAX_FLAGPOLES_PER_TEAM
+            && m_RespawnCooldownSeconds == DEFAULT_RESPAWN_COOLDOWN_SECONDS
+            && m_MinFlagpoleDistance == DEFAULT_MIN_FLAGPOLE_DISTANCE
+            && m_PurchaseCost == DEFAULT_PURCHASE_COST
+            && m_InvitationCleanupInterval == DEFAULT_INVITATION_CLEANUP_INTERVAL
+            && m_NetworkSyncInterval == DEFAULT_NETWORK_SYNC_INTERVAL
+            && m_MaxChatHistory == DEFAULT_MAX_CHAT_HISTORY
+            && m_MaxMessageLength == DEFAULT_MAX_MESSAGE_LENGTH
+            && m_ChatBurst == DEFAULT_CHAT_BURST
+            && m_ChatMessagesPerSecond == DEFAULT_CHAT_MESSAGES_PER_SECOND
+            && m_ChatDuplicateWindow == DEFAULT_CHAT_DUPLICATE_WINDOW
+            && m_ChatLogEnabled == DEFAULT_CHAT_LOG_ENABLED
+            && m_ChatFilterReloadInterval == DEFAULT_CHAT_FILTER_RELOAD_INTERVAL
+            && m_VehicleLockIdleSeconds == DEFAULT_VEHICLE_LOCK_IDLE_SECONDS
+            && m_VehicleLockProximity == DEFAULT_VEHICLE_LOCK_PROXIMITY;
+    }
+}
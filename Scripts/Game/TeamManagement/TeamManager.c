@@ -8,28 +8,31 @@
 #include "../Core/Collections.c"
 #include "../Core/IEntity.c"
 #include "../Core/EntityID.c"
+#include "TeamRoster.c"
+#include "TeamManagementSettings.c"
+#include "TeamVehicleLockRegistry.c"
 class TeamManager
 {
-    // Map of teams with team ID as key and array of team members as value
-    protected ref map<int, ref array<ref TeamMember>> m_Teams = new map<int, ref array<ref TeamMember>>();
+    // Roster storage for all teams, one slot per team; team IDs are generation-tagged slots
+    protected ref TeamRoster m_Roster = new TeamRoster();
+    
+    // Map of player handles to the team they belong to
+    protected ref map<int, int> m_PlayerTeams = new map<int, int>();
     
     // Map of pending invitations with invitation ID as key and invitation details as value
     protected ref map<string, ref TeamInvitation> m_PendingInvitations = new map<string, ref TeamInvitation>();
     
-    // Counter for team IDs
-    protected int m_TeamIDCounter = 1;
+    // Counter for invitation IDs
+    protected int m_InvitationCounter = 1;
     
     // Singleton instance
     private static ref TeamManager s_Instance;
     
-    // Maximum number of players allowed in a team
-    static const int MAX_TEAM_SIZE = 8;
-    
-    // Maximum number of flagpoles allowed per team
-    static const int MAX_FLAGPOLES_PER_TEAM = 1;
+    // Flagpoles of each team, indexed by roster slot; lists are reused when a slot is recycled
+    protected ref array<ref array<EntityID>> m_SlotFlagpoles = new array<ref array<EntityID>>();
     
-    // Map of teams to their flagpoles
-    protected ref map<int, ref array<EntityID>> m_TeamFlagpoles = new map<int, ref array<EntityID>>();
+    // Flagpoles a client learned about before their team was synced, by team ID
+    protected ref map<int, ref array<EntityID>> m_PendingFlagpoles = new map<int, ref array<EntityID>>();
     
     // Network component for multiplayer support
     protected ref TeamNetworkComponent m_NetworkComponent;
@@ -37,6 +40,21 @@ class TeamManager
     // Event invoker for team changes (playerEntityID, oldTeamID, newTeamID)
     protected ref ScriptInvoker m_OnTeamChanged = new ScriptInvoker();
     
+    // Event invoker fired once per bulk operation (touchedTeamIDs, disbandedTeamIDs)
+    protected ref ScriptInvoker m_OnTeamsBatchApplied = new ScriptInvoker();
+    
+    // Pending membership changes of the running bulk operation, one entry per player
+    protected int m_BatchDepth = 0;
+    protected ref array<int> m_BatchHandles = new array<int>();
+    protected ref array<int> m_BatchOldTeams = new array<int>();
+    protected ref array<int> m_BatchNewTeams = new array<int>();
+    protected ref map<int, int> m_BatchIndex = new map<int, int>();
+    protected ref array<int> m_BatchTouchedTeams = new array<int>();
+    protected ref array<int> m_BatchDisbandedTeams = new array<int>();
+    
+    // Vehicles whose lock was released or handed over by membership changes, replicated together
+    protected ref array<int> m_ChangedVehicleLocks = new array<int>();
+    
     /**
      * @brief Get the singleton instance of TeamManager
      * @return TeamManager instance
@@ -84,17 +102,13 @@ class TeamManager
         if (currentTeam > 0)
             return -1; // Player already in a team
         
-        int teamID = m_TeamIDCounter++;
-        
-        ref TeamMember leaderMember = new TeamMember(playerID, playerName, true);
-        leaderMember.SetTeamID(teamID);
-        ref array<ref TeamMember> newTeam = new array<ref TeamMember>();
-        newTeam.Insert(leaderMember);
-        
-        m_Teams.Insert(teamID, newTeam);
+        int teamID = m_Roster.AcquireTeam();
+        int slot = TeamRoster.GetSlotFromTeamID(teamID);
+        EnsureSlotRecords(slot);
+        AddRosterMember(teamID, slot, playerID, playerName, true);
         
         // Notify player they created a team
-        NotifyPlayer(player, "You have created a new team (ID: " + teamID + ")");
+        NotifyPlayer(player, "You have created a new team (ID: " + GetTeamDisplayNumber(teamID) + ")");
         
         // Trigger the team changed event (from no team to new team)
         TriggerTeamChanged(player, 0, teamID);
@@ -122,11 +136,11 @@ class TeamManager
             return false;
             
         // Single player or server implementation
-        if (!m_Teams.Contains(teamID))
+        int slot = GetTeamSlot(teamID);
+        if (slot < 0)
             return false; // Team doesn't exist
         
-        ref array<ref TeamMember> team = m_Teams.Get(teamID);
-        if (team.Count() >= MAX_TEAM_SIZE)
+        if (m_Roster.GetMemberCount(slot) >= TeamManagementSettings.Get().m_MaxTeamSize)
             return false; // Team is full
         
         string playerID = GetPlayerIdentity(player);
@@ -138,15 +152,13 @@ class TeamManager
             return false; // Player already in a team
         
         // Add player to team
-        ref TeamMember newMember = new TeamMember(playerID, playerName, false);
-        newMember.SetTeamID(teamID);
-        team.Insert(newMember);
+        AddRosterMember(teamID, slot, playerID, playerName, false);
         
         // Notify all team members about the new player
         NotifyTeam(teamID, playerName + " has joined your team");
         
         // Notify player they joined a team
-        NotifyPlayer(player, "You have joined team " + teamID);
+        NotifyPlayer(player, "You have joined team " + GetTeamDisplayNumber(teamID));
         
         // Trigger the team changed event (from no team to new team)
         TriggerTeamChanged(player, 0, teamID);
@@ -180,53 +192,38 @@ class TeamManager
         if (teamID <= 0)
             return false; // Player not in a team
         
-        ref array<ref TeamMember> team = m_Teams.Get(teamID);
-        if (!team)
+        int slot = GetTeamSlot(teamID);
+        if (slot < 0)
             return false; // Team doesn't exist
         
-        bool isLeader = false;
-        int memberIndex = -1;
-        
-        // Find the player in the team
-        for (int i = 0; i < team.Count(); i++)
-        {
-            if (team[i].GetPlayerID() == playerID)
-            {
-                isLeader = team[i].IsLeader();
-                memberIndex = i;
-                break;
-            }
-        }
-        
-        if (memberIndex == -1)
-            return false; // Player not found in the team
-        
         // Remove player from team
-        team.RemoveOrdered(memberIndex);
+        if (!RemoveRosterMember(teamID, playerID.ToInt()))
+            return false; // Player not found in the team
         
         // Notify remaining team members
         NotifyTeam(teamID, playerName + " has left the team");
         
         // Notify player they left the team
-        NotifyPlayer(player, "You have left team " + teamID);
+        NotifyPlayer(player, "You have left team " + GetTeamDisplayNumber(teamID));
         
-        // If player was the leader and there are still members, assign new leader
-        if (isLeader && team.Count() > 0)
+        // If player was the leader and there are still members, the longest-serving member becomes leader
+        int newLeaderIndex = EnsureTeamLeader(slot);
+        if (newLeaderIndex != -1)
         {
-            team[0].SetLeader(true);
-            string newLeaderName = team[0].GetPlayerName();
+            string newLeaderName = m_Roster.GetPlayerName(slot, newLeaderIndex);
             NotifyTeam(teamID, newLeaderName + " is now the team leader");
         }
         
-        // If team is empty, remove it
-        if (team.Count() == 0)
+        // If team is empty, disband it
+        if (m_Roster.GetMemberCount(slot) == 0)
         {
-            m_Teams.Remove(teamID);
+            ReleaseTeamSlot(slot);
         }
         
         // Trigger the team changed event (from team to no team)
         TriggerTeamChanged(player, teamID, 0);
         
+        FlushVehicleLockChanges();
         return true;
     }
     
@@ -262,8 +259,7 @@ class TeamManager
             return false; // Sender is not the team leader
         
         // Check if team is full
-        ref array<ref TeamMember> team = m_Teams.Get(teamID);
-        if (team.Count() >= MAX_TEAM_SIZE)
+        if (GetTeamMemberCount(teamID) >= TeamManagementSettings.Get().m_MaxTeamSize)
             return false; // Team is full
         
         // Check if receiver is already in a team
@@ -279,7 +275,7 @@ class TeamManager
         string receiverName = GetPlayerName(receiver);
         
         // Generate unique invitation ID
-        string invitationID = senderID + "_" + receiverID + "_" + teamID + "_" + m_TeamIDCounter;
+        string invitationID = senderID + "_" + receiverID + "_" + teamID + "_" + m_InvitationCounter++;
         
         // Create and store invitation
         ref TeamInvitation invitation = new TeamInvitation(invitationID, teamID, senderID, senderName, receiverID, receiverName);
@@ -328,7 +324,7 @@ class TeamManager
         int teamID = invitation.GetTeamID();
         
         // Check if team still exists
-        if (!m_Teams.Contains(teamID))
+        if (!TeamExists(teamID))
         {
             m_PendingInvitations.Remove(invitationID);
             NotifyPlayer(player, "The team no longer exists");
@@ -336,8 +332,7 @@ class TeamManager
         }
         
         // Check if team is now full
-        ref array<ref TeamMember> team = m_Teams.Get(teamID);
-        if (team.Count() >= MAX_TEAM_SIZE)
+        if (GetTeamMemberCount(teamID) >= TeamManagementSettings.Get().m_MaxTeamSize)
         {
             m_PendingInvitations.Remove(invitationID);
             NotifyPlayer(player, "The team is now full");
@@ -405,23 +400,370 @@ class TeamManager
         return true;
     }
     
+    //=====================================================
+    // Bulk Team Operations
+    //=====================================================
+    
     /**
-     * @brief Get the team ID a player belongs to
-     * @param playerID The identity of the player
-     * @return The team ID, or 0 if player is not in a team
+     * @brief Create several teams at once (server only)
+     * All groups are validated before anything is applied; if any group is invalid no team is created.
+     * Team change events fire once per player after the batch, and one delta is replicated.
+     * @param groups Player entity IDs per team; the first entry of each group becomes the leader
+     * @param teamIDs Output array receiving the new team IDs, in group order
+     * @return True if all teams were created, false if validation failed
      */
-    int GetPlayerTeam(string playerID)
+    bool CreateTeams(notnull array<ref array<EntityID>> groups, out array<int> teamIDs)
+    {
+        teamIDs = new array<int>();
+        if (!CanApplyBatch())
+            return false;
+        
+        // Validation pass: resolve every player once and reject duplicates or players already in a team
+        array<int> handles = new array<int>();
+        array<string> names = new array<string>();
+        set<int> seen = new set<int>();
+        int maxTeamSize = TeamManagementSettings.Get().m_MaxTeamSize;
+        foreach (array<EntityID> group : groups)
+        {
+            if (!group || group.Count() == 0 || group.Count() > maxTeamSize)
+                return false;
+            
+            foreach (EntityID entityID : group)
+            {
+                IEntity player = GetGame().GetWorld().FindEntityByID(entityID);
+                if (!player)
+                    return false;
+                
+                int playerHandle = GetPlayerIdentity(player).ToInt();
+                if (!seen.Insert(playerHandle) || GetPlayerTeamByHandle(playerHandle) > 0)
+                    return false;
+                
+                handles.Insert(playerHandle);
+                names.Insert(GetPlayerName(player));
+            }
+        }
+        
+        // Apply pass
+        BeginBatch();
+        
+        int entry = 0;
+        foreach (array<EntityID> members : groups)
+        {
+            int teamID = m_Roster.AcquireTeam();
+            int slot = TeamRoster.GetSlotFromTeamID(teamID);
+            EnsureSlotRecords(slot);
+            teamIDs.Insert(teamID);
+            
+            for (int i = 0; i < members.Count(); i++)
+            {
+                AddRosterMember(teamID, slot, handles[entry].ToString(), names[entry], i == 0);
+                RecordMembershipChange(handles[entry], 0, teamID);
+                entry++;
+            }
+            
+            m_BatchTouchedTeams.Insert(teamID);
+        }
+        
+        EndBatch();
+        return true;
+    }
+    
+    /**
+     * @brief Move several players between teams at once (server only)
+     * The final team sizes are validated before anything is applied. Teams left empty are disbanded,
+     * teams left without a leader promote their earliest member.
+     * @param assignments Map of player entity ID to target team ID (0 removes the player from their team)
+     * @return True if all assignments were applied, false if validation failed
+     */
+    bool AssignPlayers(notnull map<int, int> assignments)
     {
-        foreach (int teamID, ref array<ref TeamMember> team : m_Teams)
+        if (!CanApplyBatch())
+            return false;
+        
+        // Validation pass: resolve players and compute the resulting team sizes
+        array<int> handles = new array<int>();
+        array<string> names = new array<string>();
+        array<int> targets = new array<int>();
+        map<int, int> resultingCounts = new map<int, int>();
+        int maxTeamSize = TeamManagementSettings.Get().m_MaxTeamSize;
+        
+        foreach (int entityID, int targetTeamID : assignments)
+        {
+            IEntity player = GetGame().GetWorld().FindEntityByID(EntityID.FromInt(entityID));
+            if (!player)
+                return false;
+            
+            if (targetTeamID != 0 && !TeamExists(targetTeamID))
+                return false;
+            
+            int playerHandle = GetPlayerIdentity(player).ToInt();
+            int currentTeamID = GetPlayerTeamByHandle(playerHandle);
+            if (currentTeamID == targetTeamID)
+                continue;
+            
+            if (currentTeamID > 0)
+                resultingCounts.Set(currentTeamID, GetResultingCount(resultingCounts, currentTeamID) - 1);
+            
+            if (targetTeamID > 0)
+                resultingCounts.Set(targetTeamID, GetResultingCount(resultingCounts, targetTeamID) + 1);
+            
+            handles.Insert(playerHandle);
+            names.Insert(GetPlayerName(player));
+            targets.Insert(targetTeamID);
+        }
+        
+        // Sizes are checked once all arrivals and departures are counted, so swaps between full teams pass
+        foreach (int countedTeamID, int resultingCount : resultingCounts)
+        {
+            if (resultingCount > maxTeamSize)
+                return false;
+        }
+        
+        // Apply pass: take everyone out first so swaps between full teams succeed
+        BeginBatch();
+        
+        for (int i = 0; i < handles.Count(); i++)
         {
-            foreach (ref TeamMember member : team)
+            int oldTeamID = GetPlayerTeamByHandle(handles[i]);
+            if (oldTeamID > 0)
             {
-                if (member.GetPlayerID() == playerID)
-                    return teamID;
+                RemoveRosterMember(oldTeamID, handles[i]);
+                MarkBatchTeamTouched(oldTeamID);
             }
+            
+            RecordMembershipChange(handles[i], oldTeamID, targets[i]);
+        }
+        
+        for (int j = 0; j < handles.Count(); j++)
+        {
+            if (targets[j] <= 0)
+                continue;
+            
+            AddRosterMember(targets[j], GetTeamSlot(targets[j]), handles[j].ToString(), names[j], false);
+            MarkBatchTeamTouched(targets[j]);
+        }
+        
+        // Disband emptied teams and make sure every remaining team has a leader
+        for (int t = m_BatchTouchedTeams.Count() - 1; t >= 0; t--)
+        {
+            int teamID = m_BatchTouchedTeams[t];
+            int slot = GetTeamSlot(teamID);
+            if (m_Roster.GetMemberCount(slot) == 0)
+            {
+                ReleaseTeamSlot(slot);
+                m_BatchTouchedTeams.Remove(t);
+                m_BatchDisbandedTeams.Insert(teamID);
+                continue;
+            }
+            
+            EnsureTeamLeader(slot);
+        }
+        
+        EndBatch();
+        return true;
+    }
+    
+    /**
+     * @brief Disband every team at once (server only)
+     */
+    void DisbandAll()
+    {
+        if (!CanApplyBatch())
+            return;
+        
+        BeginBatch();
+        
+        for (int slot = 0; slot < m_Roster.GetSlotCapacity(); slot++)
+        {
+            if (!m_Roster.IsSlotInUse(slot))
+                continue;
+            
+            int teamID = m_Roster.MakeTeamID(slot);
+            int count = m_Roster.GetMemberCount(slot);
+            for (int i = 0; i < count; i++)
+            {
+                RecordMembershipChange(m_Roster.GetPlayerHandle(slot, i), teamID, 0);
+            }
+            
+            ReleaseTeamSlot(slot);
+            m_BatchDisbandedTeams.Insert(teamID);
         }
         
-        return 0; // Not in a team
+        EndBatch();
+    }
+    
+    /**
+     * @brief Get the OnTeamsBatchApplied event invoker
+     * Invoked once per bulk operation with (array<int> touchedTeamIDs, array<int> disbandedTeamIDs),
+     * after the per-player OnTeamChanged events of that batch.
+     * @return The ScriptInvoker for batch events
+     */
+    ScriptInvoker GetOnTeamsBatchApplied()
+    {
+        return m_OnTeamsBatchApplied;
+    }
+    
+    /**
+     * @brief Check whether bulk operations may run on this machine
+     * @return True on the server or in single player
+     */
+    protected bool CanApplyBatch()
+    {
+        if (GetGame().IsMultiplayer() && !GetGame().IsServer())
+        {
+            Print("TeamManager: Bulk team operations are server only");
+            return false;
+        }
+        
+        return m_BatchDepth == 0;
+    }
+    
+    /**
+     * @brief Start collecting membership changes instead of firing events per change
+     */
+    protected void BeginBatch()
+    {
+        m_BatchDepth++;
+        if (m_BatchDepth > 1)
+            return;
+        
+        m_BatchHandles.Clear();
+        m_BatchOldTeams.Clear();
+        m_BatchNewTeams.Clear();
+        m_BatchIndex.Clear();
+        m_BatchTouchedTeams.Clear();
+        m_BatchDisbandedTeams.Clear();
+    }
+    
+    /**
+     * @brief Finish a batch: notify, fire coalesced events and replicate one delta
+     */
+    protected void EndBatch()
+    {
+        m_BatchDepth--;
+        if (m_BatchDepth > 0)
+            return;
+        
+        // Resolve player entities once for the whole batch
+        map<int, IEntity> playerEntities = new map<int, IEntity>();
+        array<EntityID> playerIDs = new array<EntityID>();
+        GetGame().GetWorld().GetPlayerManager().GetPlayerIDs(playerIDs);
+        foreach (EntityID id : playerIDs)
+        {
+            IEntity player = GetGame().GetWorld().FindEntityByID(id);
+            if (player)
+                playerEntities.Set(GetPlayerIdentity(player).ToInt(), player);
+        }
+        
+        for (int i = 0; i < m_BatchHandles.Count(); i++)
+        {
+            int oldTeamID = m_BatchOldTeams[i];
+            int newTeamID = m_BatchNewTeams[i];
+            if (oldTeamID == newTeamID)
+                continue; // Changes cancelled out within the batch
+            
+            IEntity changedPlayer = playerEntities.Get(m_BatchHandles[i]);
+            if (!changedPlayer)
+                continue;
+            
+            if (newTeamID > 0)
+                NotifyPlayer(changedPlayer, "You have been assigned to team " + GetTeamDisplayNumber(newTeamID));
+            else
+                NotifyPlayer(changedPlayer, "You are no longer in a team");
+            
+            TriggerTeamChanged(changedPlayer, oldTeamID, newTeamID);
+        }
+        
+        m_OnTeamsBatchApplied.Invoke(m_BatchTouchedTeams, m_BatchDisbandedTeams);
+        
+        if (GetGame().IsMultiplayer() && GetGame().IsServer() && m_NetworkComponent)
+            m_NetworkComponent.BroadcastTeamDelta(m_BatchTouchedTeams, m_BatchDisbandedTeams);
+        
+        FlushVehicleLockChanges();
+    }
+    
+    /**
+     * @brief Replicate the vehicle locks changed by membership changes in one update
+     */
+    protected void FlushVehicleLockChanges()
+    {
+        if (m_ChangedVehicleLocks.Count() == 0)
+            return;
+        
+        if (GetGame().IsMultiplayer() && GetGame().IsServer() && m_NetworkComponent)
+            m_NetworkComponent.BroadcastVehicleLockStates(m_ChangedVehicleLocks);
+        
+        m_ChangedVehicleLocks.Clear();
+    }
+    
+    /**
+     * @brief Record a membership change for the current batch, coalescing repeated changes per player
+     * @param playerHandle The player handle
+     * @param oldTeamID The team the player left (0 for none)
+     * @param newTeamID The team the player joined (0 for none)
+     */
+    protected void RecordMembershipChange(int playerHandle, int oldTeamID, int newTeamID)
+    {
+        int index;
+        if (m_BatchIndex.Find(playerHandle, index))
+        {
+            // Keep the first old team and the last new team
+            m_BatchNewTeams[index] = newTeamID;
+            return;
+        }
+        
+        m_BatchIndex.Set(playerHandle, m_BatchHandles.Count());
+        m_BatchHandles.Insert(playerHandle);
+        m_BatchOldTeams.Insert(oldTeamID);
+        m_BatchNewTeams.Insert(newTeamID);
+    }
+    
+    /**
+     * @brief Add a team to the touched list of the current batch once
+     * @param teamID The ID of the team
+     */
+    protected void MarkBatchTeamTouched(int teamID)
+    {
+        if (m_BatchTouchedTeams.Find(teamID) == -1)
+            m_BatchTouchedTeams.Insert(teamID);
+    }
+    
+    /**
+     * @brief Get a team's size as it will be after the pending assignments
+     * @param resultingCounts Sizes already adjusted by earlier assignments
+     * @param teamID The ID of the team
+     * @return The resulting member count
+     */
+    protected int GetResultingCount(map<int, int> resultingCounts, int teamID)
+    {
+        int count;
+        if (resultingCounts.Find(teamID, count))
+            return count;
+        
+        return GetTeamMemberCount(teamID);
+    }
+    
+    /**
+     * @brief Get the team ID a player belongs to
+     * @param playerID The identity of the player
+     * @return The team ID, or 0 if player is not in a team
+     */
+    int GetPlayerTeam(string playerID)
+    {
+        if (playerID.Length() == 0)
+            return 0;
+        
+        return GetPlayerTeamByHandle(playerID.ToInt());
+    }
+    
+    /**
+     * @brief Get the team ID a player belongs to
+     * @param playerHandle The numeric player handle
+     * @return The team ID, or 0 if player is not in a team
+     */
+    int GetPlayerTeamByHandle(int playerHandle)
+    {
+        return m_PlayerTeams.Get(playerHandle); // 0 when not in a team
     }
     
     /**
@@ -432,59 +774,173 @@ class TeamManager
      */
     bool IsTeamLeader(string playerID, int teamID)
     {
-        ref array<ref TeamMember> team = m_Teams.Get(teamID);
-        if (!team)
+        int slot = GetTeamSlot(teamID);
+        if (slot < 0)
             return false;
         
-        foreach (ref TeamMember member : team)
-        {
-            if (member.GetPlayerID() == playerID && member.IsLeader())
-                return true;
-        }
+        int memberIndex = m_Roster.FindMember(slot, playerID.ToInt());
+        if (memberIndex == -1)
+            return false;
         
-        return false;
+        return m_Roster.IsLeader(slot, memberIndex);
     }
     
     /**
-     * @brief Get all members of a team
+     * @brief Get a snapshot of all members of a team
+     * Allocates one TeamMember per member; per-member loops should use
+     * GetTeamMemberCount and the indexed accessors instead.
      * @param teamID The ID of the team
      * @return Array of team members, or null if team doesn't exist
      */
     array<ref TeamMember> GetTeamMembers(int teamID)
     {
-        return m_Teams.Get(teamID);
+        int slot = GetTeamSlot(teamID);
+        if (slot < 0)
+            return null;
+        
+        array<ref TeamMember> members = new array<ref TeamMember>();
+        int count = m_Roster.GetMemberCount(slot);
+        for (int i = 0; i < count; i++)
+        {
+            members.Insert(CreateMemberSnapshot(teamID, slot, i));
+        }
+        
+        return members;
+    }
+    
+    /**
+     * @brief Get the number of members in a team
+     * @param teamID The ID of the team
+     * @return The member count, or 0 if team doesn't exist
+     */
+    int GetTeamMemberCount(int teamID)
+    {
+        return m_Roster.GetMemberCount(GetTeamSlot(teamID));
+    }
+    
+    /**
+     * @brief Get the identity of a team member by index
+     * @param teamID The ID of the team
+     * @param index The member index (0 to GetTeamMemberCount - 1)
+     * @return The player's identity string
+     */
+    string GetTeamMemberPlayerID(int teamID, int index)
+    {
+        return GetTeamMemberHandle(teamID, index).ToString();
+    }
+    
+    /**
+     * @brief Get the player handle of a team member by index
+     * @param teamID The ID of the team
+     * @param index The member index (0 to GetTeamMemberCount - 1)
+     * @return The player handle, or 0 if out of range
+     */
+    int GetTeamMemberHandle(int teamID, int index)
+    {
+        int slot = GetTeamSlot(teamID);
+        if (index < 0 || index >= m_Roster.GetMemberCount(slot))
+            return 0;
+        
+        return m_Roster.GetPlayerHandle(slot, index);
+    }
+    
+    /**
+     * @brief Get the name of a team member by index
+     * @param teamID The ID of the team
+     * @param index The member index (0 to GetTeamMemberCount - 1)
+     * @return The player's name, or empty string if out of range
+     */
+    string GetTeamMemberName(int teamID, int index)
+    {
+        int slot = GetTeamSlot(teamID);
+        if (index < 0 || index >= m_Roster.GetMemberCount(slot))
+            return "";
+        
+        return m_Roster.GetPlayerName(slot, index);
+    }
+    
+    /**
+     * @brief Check if a team member is the leader by index
+     * @param teamID The ID of the team
+     * @param index The member index (0 to GetTeamMemberCount - 1)
+     * @return True if the member is the leader
+     */
+    bool IsTeamMemberLeader(int teamID, int index)
+    {
+        int slot = GetTeamSlot(teamID);
+        if (index < 0 || index >= m_Roster.GetMemberCount(slot))
+            return false;
+        
+        return m_Roster.IsLeader(slot, index);
     }
     
     /**
      * @brief Register a flagpole for a team
+     * This is the team's list of respawn points; TeamRespawnComponent keeps it current on
+     * the server and on clients whenever a flagpole changes team or is deleted.
      * @param teamID The ID of the team
+     * On a client the team may not be synced yet; the flagpole is then kept pending and
+     * added once CreateTeamStructure creates the team.
      * @param flagpoleEntityID The entity ID of the flagpole
-     * @return True if successful, false if team already has max number of flagpoles
+     * @return True if successful or pending, false if the team does not exist or already has max number of flagpoles
      */
     bool RegisterFlagpole(int teamID, EntityID flagpoleEntityID)
     {
         // Check if the team exists
-        if (!m_Teams.Contains(teamID))
-            return false;
-            
-        // Create the array if it doesn't exist
-        if (!m_TeamFlagpoles.Contains(teamID))
+        if (!TeamExists(teamID))
         {
-            m_TeamFlagpoles.Insert(teamID, new array<EntityID>());
+            if (!GetGame().IsMultiplayer() || GetGame().IsServer())
+                return false;
+            
+            array<EntityID> pending;
+            if (!m_PendingFlagpoles.Find(teamID, pending))
+            {
+                pending = new array<EntityID>();
+                m_PendingFlagpoles.Set(teamID, pending);
+            }
+            
+            if (pending.Find(flagpoleEntityID) < 0)
+                pending.Insert(flagpoleEntityID);
+            
+            return true;
         }
-        
-        ref array<EntityID> flagpoles = m_TeamFlagpoles.Get(teamID);
+            
+        array<EntityID> flagpoles = m_SlotFlagpoles[GetTeamSlot(teamID)];
         
         // Check if team has reached the maximum number of flagpoles
-        if (flagpoles.Count() >= MAX_FLAGPOLES_PER_TEAM)
+        if (flagpoles.Count() >= TeamManagementSettings.Get().m_MaxFlagpolesPerTeam)
             return false;
             
         // Add the flagpole EntityID to the team
-        flagpoles.Insert(flagpoleEntityID);
+        if (flagpoles.Find(flagpoleEntityID) < 0)
+            flagpoles.Insert(flagpoleEntityID);
         
         return true;
     }
     
+    /**
+     * @brief Remove a flagpole from a team, e.g. when it is destroyed or given to another team
+     * @param teamID The ID of the team
+     * @param flagpoleEntityID The entity ID of the flagpole
+     */
+    void UnregisterFlagpole(int teamID, EntityID flagpoleEntityID)
+    {
+        int slot = GetTeamSlot(teamID);
+        if (slot >= 0)
+        {
+            m_SlotFlagpoles[slot].RemoveItem(flagpoleEntityID);
+            return;
+        }
+        
+        array<EntityID> pending;
+        if (!m_PendingFlagpoles.Find(teamID, pending))
+            return;
+        
+        pending.RemoveItem(flagpoleEntityID);
+        if (pending.Count() == 0)
+            m_PendingFlagpoles.Remove(teamID);
+    }
+    
     /**
      * @brief Get the number of flagpoles a team has
      * @param teamID The ID of the team
@@ -492,10 +948,11 @@ class TeamManager
      */
     int GetTeamFlagpoleCount(int teamID)
     {
-        if (!m_TeamFlagpoles.Contains(teamID))
+        int slot = GetTeamSlot(teamID);
+        if (slot < 0)
             return 0;
             
-        return m_TeamFlagpoles.Get(teamID).Count();
+        return m_SlotFlagpoles[slot].Count();
     }
     
     /**
@@ -505,10 +962,11 @@ class TeamManager
      */
     array<EntityID> GetTeamFlagpoles(int teamID)
     {
-        if (!m_TeamFlagpoles.Contains(teamID))
+        int slot = GetTeamSlot(teamID);
+        if (slot < 0)
             return new array<EntityID>();
             
-        return m_TeamFlagpoles.Get(teamID);
+        return m_SlotFlagpoles[slot];
     }
     
     /**
@@ -522,18 +980,14 @@ class TeamManager
         if (!playerEntity)
             return null;
             
-        string playerID = GetPlayerIdentity(playerEntity);
-        
-        foreach (int teamID, ref array<ref TeamMember> team : m_Teams)
-        {
-            foreach (ref TeamMember member : team)
-            {
-                if (member.GetPlayerID() == playerID)
-                    return member;
-            }
-        }
+        int playerHandle = GetPlayerIdentity(playerEntity).ToInt();
+        int teamID = GetPlayerTeamByHandle(playerHandle);
+        int slot = GetTeamSlot(teamID);
+        int memberIndex = m_Roster.FindMember(slot, playerHandle);
+        if (memberIndex == -1)
+            return null;
         
-        return null;
+        return CreateMemberSnapshot(teamID, slot, memberIndex);
     }
     
     /**
@@ -571,7 +1025,18 @@ class TeamManager
      */
     bool TeamExists(int teamID)
     {
-        return m_Teams.Contains(teamID);
+        return m_Roster.ResolveTeamID(teamID) >= 0;
+    }
+    
+    /**
+     * @brief Get the short team number shown to players
+     * Team IDs are generation-tagged; the number is stable for as long as the team exists.
+     * @param teamID The ID of the team
+     * @return The display number (1-based)
+     */
+    static int GetTeamDisplayNumber(int teamID)
+    {
+        return TeamRoster.GetSlotFromTeamID(teamID) + 1;
     }
     
     /**
@@ -581,14 +1046,26 @@ class TeamManager
      */
     void CreateTeamStructure(int teamID)
     {
-        if (!m_Teams.Contains(teamID))
+        if (TeamExists(teamID))
+            return;
+        
+        // Drop whatever older team the client still has in this slot
+        int slot = TeamRoster.GetSlotFromTeamID(teamID);
+        if (m_Roster.IsSlotInUse(slot))
+            ReleaseTeamSlot(slot);
+        
+        slot = m_Roster.ClaimTeam(teamID);
+        if (slot < 0)
+            return;
+        
+        EnsureSlotRecords(slot);
+        
+        // Flagpoles replicated before the team arrived; the server already checked the limit
+        array<EntityID> pending;
+        if (m_PendingFlagpoles.Find(teamID, pending))
         {
-            ref array<ref TeamMember> newTeam = new array<ref TeamMember>();
-            m_Teams.Insert(teamID, newTeam);
-            
-            // Update team ID counter if needed
-            if (teamID >= m_TeamIDCounter)
-                m_TeamIDCounter = teamID + 1;
+            m_SlotFlagpoles[slot].InsertAll(pending);
+            m_PendingFlagpoles.Remove(teamID);
         }
     }
     
@@ -599,11 +1076,37 @@ class TeamManager
      */
     void ClearTeamMembers(int teamID)
     {
-        if (m_Teams.Contains(teamID))
+        int slot = GetTeamSlot(teamID);
+        if (slot < 0)
+            return;
+        
+        int count = m_Roster.GetMemberCount(slot);
+        for (int i = 0; i < count; i++)
         {
-            ref array<ref TeamMember> team = m_Teams.Get(teamID);
-            team.Clear();
+            // A player may already be indexed to the team they moved to
+            int playerHandle = m_Roster.GetPlayerHandle(slot, i);
+            if (m_PlayerTeams.Get(playerHandle) == teamID)
+                m_PlayerTeams.Remove(playerHandle);
         }
+        
+        m_Roster.ClearMembers(slot);
+        TeamVehicleLockRegistry.GetInstance().InvalidateAccess();
+    }
+    
+    /**
+     * @brief Remove a team and its members
+     * Used for network synchronization
+     * @param teamID The ID of the team
+     */
+    void DisbandTeamStructure(int teamID)
+    {
+        int slot = GetTeamSlot(teamID);
+        if (slot < 0)
+            return;
+        
+        ClearTeamMembers(teamID);
+        ReleaseTeamSlot(slot);
+        FlushVehicleLockChanges();
     }
     
     /**
@@ -616,14 +1119,140 @@ class TeamManager
      */
     void AddTeamMember(int teamID, string playerID, string playerName, bool isLeader)
     {
-        if (m_Teams.Contains(teamID))
+        int slot = GetTeamSlot(teamID);
+        if (slot >= 0)
+            AddRosterMember(teamID, slot, playerID, playerName, isLeader);
+    }
+    
+    /**
+     * @brief Get the roster slot of a team
+     * @param teamID The ID of the team
+     * @return The slot index, or -1 if team doesn't exist
+     */
+    protected int GetTeamSlot(int teamID)
+    {
+        return m_Roster.ResolveTeamID(teamID);
+    }
+    
+    /**
+     * @brief Make sure the per-slot team records exist up to a slot
+     * Records are only created the first time a slot is used and are reused afterwards.
+     * @param slot The roster slot
+     */
+    protected void EnsureSlotRecords(int slot)
+    {
+        while (m_SlotFlagpoles.Count() <= slot)
         {
-            ref array<ref TeamMember> team = m_Teams.Get(teamID);
-            ref TeamMember newMember = new TeamMember(playerID, playerName, isLeader);
-            team.Insert(newMember);
+            m_SlotFlagpoles.Insert(new array<EntityID>());
         }
     }
     
+    /**
+     * @brief Disband the team in a slot and recycle the slot
+     * @param slot The roster slot
+     */
+    protected void ReleaseTeamSlot(int slot)
+    {
+        int count = m_Roster.GetMemberCount(slot);
+        for (int i = 0; i < count; i++)
+        {
+            m_PlayerTeams.Remove(m_Roster.GetPlayerHandle(slot, i));
+        }
+        
+        if (slot < m_SlotFlagpoles.Count())
+            m_SlotFlagpoles[slot].Clear();
+        
+        TeamVehicleLockRegistry.GetInstance().InvalidateAccess();
+        
+        if (m_NetworkComponent)
+            m_NetworkComponent.ReleaseTeamChat(m_Roster.MakeTeamID(slot));
+        
+        // Vehicles of a disbanded team are unlocked; clients learn about it from the server
+        if (!GetGame().IsMultiplayer() || GetGame().IsServer())
+            TeamVehicleLockRegistry.GetInstance().ReleaseTeamLocks(m_Roster.MakeTeamID(slot), m_ChangedVehicleLocks);
+        
+        m_Roster.ReleaseSlot(slot);
+    }
+    
+    /**
+     * @brief Append a member to a team's roster slot and index the player
+     * @param teamID The ID of the team
+     * @param slot The team's roster slot
+     * @param playerID The identity of the player
+     * @param playerName The name of the player
+     * @param isLeader Whether the player is the team leader
+     * @return True if the member was added, false if the slot is full
+     */
+    protected bool AddRosterMember(int teamID, int slot, string playerID, string playerName, bool isLeader)
+    {
+        int playerHandle = playerID.ToInt();
+        float joinTimestamp = GetGame().GetWorld().GetWorldTime();
+        if (m_Roster.AddMember(slot, playerHandle, playerName, isLeader, joinTimestamp) == -1)
+            return false;
+        
+        m_PlayerTeams.Set(playerHandle, teamID);
+        TeamVehicleLockRegistry.GetInstance().InvalidateAccess();
+        return true;
+    }
+    
+    /**
+     * @brief Remove a player from a team's roster slot and the player index
+     * @param teamID The ID of the team
+     * @param playerHandle The player handle
+     * @return True if the player was removed, false if not in the team
+     */
+    protected bool RemoveRosterMember(int teamID, int playerHandle)
+    {
+        int slot = GetTeamSlot(teamID);
+        int memberIndex = m_Roster.FindMember(slot, playerHandle);
+        if (memberIndex == -1)
+            return false;
+        
+        m_Roster.RemoveMemberAt(slot, memberIndex);
+        m_PlayerTeams.Remove(playerHandle);
+        TeamVehicleLockRegistry.GetInstance().InvalidateAccess();
+        
+        // The team keeps the vehicles the player locked, the player loses access to them
+        TeamVehicleLockRegistry.GetInstance().TransferOwnerLocks(playerHandle, 0, m_ChangedVehicleLocks);
+        return true;
+    }
+    
+    /**
+     * @brief Promote the longest-serving member if a non-empty team has no leader
+     * @param slot The team's roster slot
+     * @return The index of the newly promoted leader, or -1 if no promotion happened
+     */
+    protected int EnsureTeamLeader(int slot)
+    {
+        int count = m_Roster.GetMemberCount(slot);
+        for (int i = 0; i < count; i++)
+        {
+            if (m_Roster.IsLeader(slot, i))
+                return -1;
+        }
+        
+        int newLeaderIndex = m_Roster.FindEarliestMember(slot);
+        if (newLeaderIndex != -1)
+            m_Roster.SetLeader(slot, newLeaderIndex, true);
+        
+        return newLeaderIndex;
+    }
+    
+    /**
+     * @brief Build a TeamMember object from a roster entry
+     * @param teamID The ID of the team
+     * @param slot The team's roster slot
+     * @param index The member index
+     * @return New TeamMember snapshot
+     */
+    protected TeamMember CreateMemberSnapshot(int teamID, int slot, int index)
+    {
+        TeamMember member = new TeamMember(m_Roster.GetPlayerHandle(slot, index).ToString(), m_Roster.GetPlayerName(slot, index), m_Roster.IsLeader(slot, index));
+        member.SetTeamID(teamID);
+        member.SetJoinTimestamp(m_Roster.GetJoinTimestamp(slot, index));
+        return member;
+    }
+    
     /**
      * @brief Get the identity of a player entity
      * @param player The player entity
@@ -717,13 +1346,11 @@ class TeamManager
      */
     private void NotifyTeam(int teamID, string message)
     {
-        ref array<ref TeamMember> team = m_Teams.Get(teamID);
-        if (!team)
-            return;
-        
-        foreach (ref TeamMember member : team)
+        int slot = GetTeamSlot(teamID);
+        int count = m_Roster.GetMemberCount(slot);
+        for (int i = 0; i < count; i++)
         {
-            IEntity player = GetPlayerByIdentity(member.GetPlayerID());
+            IEntity player = GetPlayerByIdentity(m_Roster.GetPlayerHandle(slot, i).ToString());
             if (player)
                 NotifyPlayer(player, message);
         }
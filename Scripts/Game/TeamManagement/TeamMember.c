@@ -86,6 +86,15 @@ class TeamMember
         return m_JoinTimestamp;
     }
     
+    /**
+     * @brief Set the timestamp when the player joined the team
+     * @param joinTimestamp The join timestamp
+     */
+    void SetJoinTimestamp(float joinTimestamp)
+    {
+        m_JoinTimestamp = joinTimestamp;
+    }
+    
     /**
      * @brief Get the team ID this member belongs to
      * @return The team ID
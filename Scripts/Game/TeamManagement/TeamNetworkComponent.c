@@ -13,6 +13,12 @@
 // Include the network-related classes so other files can find them
 #include "../Network/ScriptCallContext.c"
 #include "../Network/Rpc/Rpc.c"
+#include "TeamChatRateLimiter.c"
+#include "TeamChatBatcher.c"
+#include "TeamChatLog.c"
+#include "TeamChatFilter.c"
+#include "TeamPing.c"
+#include "TeamVehicleLockRegistry.c"
 
 // Classes have been moved to their respective files:
 // - ScriptCallContext is now in ../Network/ScriptCallContext.c 
@@ -26,6 +32,10 @@ class RplComponent
     protected EntityID m_OwnerID;
     protected int m_ID;
     
+    // RPCs sent and their payload in bytes since the last ResetSentStats, for profiling
+    protected static int s_SentRpcCount = 0;
+    protected static int s_SentBytes = 0;
+    
     void RplComponent(EntityID ownerID = 0)
     {
         m_OwnerID = ownerID;
@@ -36,9 +46,20 @@ class RplComponent
     {
         // In our implementation, we just log the RPC call
         Print(string.Format("Sending RPC: %1 to %2", functionName, targetID));
+        s_SentRpcCount++;
+        s_SentBytes += context.GetSize();
         return true;
     }
     
+    static int GetSentRpcCount() { return s_SentRpcCount; }
+    static int GetSentBytes() { return s_SentBytes; }
+    
+    static void ResetSentStats()
+    {
+        s_SentRpcCount = 0;
+        s_SentBytes = 0;
+    }
+    
     EntityID GetOwnerID() { return m_OwnerID; }
     void SetOwnerID(EntityID ownerID) { m_OwnerID = ownerID; }
     
@@ -69,6 +90,21 @@ class TeamNetworkComponent : ScriptedWidgetComponent
     // The team manager reference
     protected ref TeamManager m_TeamManager;
     
+    // Per-sender chat limits enforced before the server forwards a message
+    protected ref TeamChatRateLimiter m_ChatRateLimiter = new TeamChatRateLimiter();
+    
+    // Outbound team chat collected until the next flush
+    protected ref TeamChatBatcher m_ChatBatcher = new TeamChatBatcher();
+    
+    // Keyword filter applied to team chat before it is forwarded
+    protected ref TeamChatFilter m_ChatFilter = new TeamChatFilter();
+    
+    // Moderation log of accepted team chat; server only
+    protected ref TeamChatLog m_ChatLog;
+    
+    // Next chat sequence number per team ID; server only
+    protected ref map<int, int> m_ChatSequences = new map<int, int>();
+    
     // RPC constants
     protected const string RPC_CREATE_TEAM = "RPC_CreateTeam";
     protected const string RPC_JOIN_TEAM = "RPC_JoinTeam";
@@ -80,6 +116,16 @@ class TeamNetworkComponent : ScriptedWidgetComponent
     protected const string RPC_LOCK_VEHICLE = "RPC_LockVehicle";
     protected const string RPC_UNLOCK_VEHICLE = "RPC_UnlockVehicle";
     protected const string RPC_TEAM_CHAT_MESSAGE = "RPC_TeamChatMessage";
+    protected const string RPC_TEAM_DELTA = "RPC_TeamDelta";
+    protected const string RPC_TEAM_CHAT_BATCH = "RPC_TeamChatBatch";
+    protected const string RPC_TEAM_PING = "RPC_TeamPing";
+    protected const string RPC_LOCK_VEHICLES = "RPC_LockVehicles";
+    protected const string RPC_RESERVE_SEAT = "RPC_ReserveSeat";
+    protected const string RPC_SYNC_SETTINGS = "RPC_SyncSettings";
+    
+    // Limits of one convoy lock request
+    protected const int MAX_CONVOY_VEHICLES = 32;
+    protected const float MAX_CONVOY_RADIUS = 250.0;
     
     /**
      * @brief Get the singleton instance
@@ -100,6 +146,14 @@ class TeamNetworkComponent : ScriptedWidgetComponent
     {
         m_TeamManager = TeamManager.GetInstance();
         
+        if (GetGame().IsServer())
+        {
+            m_ChatFilter.Reload();
+            
+            if (TeamManagementSettings.Get().m_ChatLogEnabled)
+                m_ChatLog = new TeamChatLog();
+        }
+        
         // Register RPC handlers
         RplComponent rpl = RplComponent.Cast(GetGame().GetRplComponent());
         if (rpl)
@@ -114,6 +168,12 @@ class TeamNetworkComponent : ScriptedWidgetComponent
             rpl.RegisterHandler(RPC_LOCK_VEHICLE, this, "OnRPC_LockVehicle");
             rpl.RegisterHandler(RPC_UNLOCK_VEHICLE, this, "OnRPC_UnlockVehicle");
             rpl.RegisterHandler(RPC_TEAM_CHAT_MESSAGE, this, "OnRPC_TeamChatMessage");
+            rpl.RegisterHandler(RPC_TEAM_DELTA, this, "OnRPC_TeamDelta");
+            rpl.RegisterHandler(RPC_TEAM_CHAT_BATCH, this, "OnRPC_TeamChatBatch");
+            rpl.RegisterHandler(RPC_TEAM_PING, this, "OnRPC_TeamPing");
+            rpl.RegisterHandler(RPC_LOCK_VEHICLES, this, "OnRPC_LockVehicles");
+            rpl.RegisterHandler(RPC_RESERVE_SEAT, this, "OnRPC_ReserveSeat");
+            rpl.RegisterHandler(RPC_SYNC_SETTINGS, this, "OnRPC_SyncSettings");
         }
     }
     
@@ -371,15 +431,12 @@ class TeamNetworkComponent : ScriptedWidgetComponent
                     rpc.WriteBool(success);
                     
                     // Broadcast to all players in the team
-                    array<ref TeamMember> teamMembers = m_TeamManager.GetTeamMembers(teamID);
-                    if (teamMembers)
+                    int memberCount = m_TeamManager.GetTeamMemberCount(teamID);
+                    for (int i = 0; i < memberCount; i++)
                     {
-                        foreach (ref TeamMember member : teamMembers)
-                        {
-                            IEntity memberEntity = GetPlayerByIdentity(member.GetPlayerID());
-                            if (memberEntity)
-                                rpl.SendRPC(RPC_ACCEPT_INVITATION, rpc, true, memberEntity);
-                        }
+                        IEntity memberEntity = GetPlayerByIdentity(m_TeamManager.GetTeamMemberPlayerID(teamID, i));
+                        if (memberEntity)
+                            rpl.SendRPC(RPC_ACCEPT_INVITATION, rpc, true, memberEntity);
                     }
                     
                     // Also send to sender if they're not in the team anymore
@@ -461,6 +518,42 @@ class TeamNetworkComponent : ScriptedWidgetComponent
         }
     }
     
+    /**
+     * @brief Send the server's settings to a player
+     * Clients do not read the settings file, so this runs before their first team sync.
+     * @param player The player entity to send to
+     */
+    void SyncSettings(IEntity player)
+    {
+        if (!GetGame().IsServer() || !player)
+            return;
+        
+        RplComponent rpl = RplComponent.Cast(GetGame().GetRplComponent());
+        if (!rpl)
+            return;
+        
+        ScriptCallContext rpc = new ScriptCallContext();
+        TeamManagementSettings.Get().SerializeReplicated(rpc);
+        rpl.SendRPC(RPC_SYNC_SETTINGS, rpc, player.GetID());
+    }
+    
+    /**
+     * @brief RPC handler for the server's settings
+     * @param rpl Replication component
+     * @param ctx Script call context for RPC
+     */
+    void OnRPC_SyncSettings(RplComponent rpl, ScriptCallContext ctx)
+    {
+        if (GetGame().IsServer())
+        {
+            // The server loaded them from its profile
+            return;
+        }
+        
+        TeamManagementSettings.DeserializeReplicated(ctx);
+        Print("TeamNetworkComponent: Settings received from server");
+    }
+    
     /**
      * @brief Sync team data to a specific player
      * @param playerEntityID The entity ID of the player to sync with
@@ -482,8 +575,8 @@ class TeamNetworkComponent : ScriptedWidgetComponent
         if (teamID <= 0)
             return; // Player not in a team
         
-        array<ref TeamMember> teamMembers = m_TeamManager.GetTeamMembers(teamID);
-        if (!teamMembers)
+        int memberCount = m_TeamManager.GetTeamMemberCount(teamID);
+        if (memberCount == 0)
             return;
         
         // Serialize team data
@@ -492,13 +585,13 @@ class TeamNetworkComponent : ScriptedWidgetComponent
         {
             ScriptCallContext rpc = new ScriptCallContext();
             rpc.WriteInt(teamID);
-            rpc.WriteInt(teamMembers.Count());
+            rpc.WriteInt(memberCount);
             
-            foreach (ref TeamMember member : teamMembers)
+            for (int i = 0; i < memberCount; i++)
             {
-                rpc.WriteString(member.GetPlayerID());
-                rpc.WriteString(member.GetPlayerName());
-                rpc.WriteBool(member.IsLeader());
+                rpc.WriteString(m_TeamManager.GetTeamMemberPlayerID(teamID, i));
+                rpc.WriteString(m_TeamManager.GetTeamMemberName(teamID, i));
+                rpc.WriteBool(m_TeamManager.IsTeamMemberLeader(teamID, i));
             }
             
             // Send to player
@@ -506,6 +599,134 @@ class TeamNetworkComponent : ScriptedWidgetComponent
         }
     }
     
+    /**
+     * @brief Replicate the result of a bulk team operation in a single packet
+     * @param touchedTeamIDs Teams whose rosters changed; their full rosters are sent
+     * @param disbandedTeamIDs Teams that no longer exist
+     */
+    void BroadcastTeamDelta(array<int> touchedTeamIDs, array<int> disbandedTeamIDs)
+    {
+        if (!GetGame().IsServer())
+            return; // Only server can replicate team state
+        
+        RplComponent rpl = RplComponent.Cast(GetGame().GetRplComponent());
+        if (!rpl)
+            return;
+        
+        ScriptCallContext rpc = new ScriptCallContext();
+        rpc.WriteInt(disbandedTeamIDs.Count());
+        foreach (int disbandedTeamID : disbandedTeamIDs)
+        {
+            rpc.WriteInt(disbandedTeamID);
+        }
+        
+        rpc.WriteInt(touchedTeamIDs.Count());
+        foreach (int teamID : touchedTeamIDs)
+        {
+            int memberCount = m_TeamManager.GetTeamMemberCount(teamID);
+            rpc.WriteInt(teamID);
+            rpc.WriteInt(memberCount);
+            
+            for (int i = 0; i < memberCount; i++)
+            {
+                rpc.WriteInt(m_TeamManager.GetTeamMemberHandle(teamID, i));
+                rpc.WriteString(m_TeamManager.GetTeamMemberName(teamID, i));
+                rpc.WriteBool(m_TeamManager.IsTeamMemberLeader(teamID, i));
+            }
+        }
+        
+        rpl.SendRPC(RPC_TEAM_DELTA, rpc);
+    }
+    
+    /**
+     * @brief RPC handler for team deltas produced by bulk team operations
+     * @param rpl Replication component
+     * @param ctx Script call context for RPC
+     */
+    void OnRPC_TeamDelta(RplComponent rpl, ScriptCallContext ctx)
+    {
+        if (GetGame().IsServer())
+        {
+            // Already applied by server-side code
+            return;
+        }
+        
+        // Team of every affected player before the delta, by player handle
+        map<int, int> oldTeams = new map<int, int>();
+        
+        array<int> disbandedTeamIDs = new array<int>();
+        int disbandedCount = ctx.ReadInt();
+        for (int i = 0; i < disbandedCount; i++)
+        {
+            int disbandedTeamID = ctx.ReadInt();
+            RecordOldTeams(disbandedTeamID, oldTeams);
+            m_TeamManager.DisbandTeamStructure(disbandedTeamID);
+            disbandedTeamIDs.Insert(disbandedTeamID);
+        }
+        
+        array<int> touchedTeamIDs = new array<int>();
+        int touchedCount = ctx.ReadInt();
+        for (int t = 0; t < touchedCount; t++)
+        {
+            int teamID = ctx.ReadInt();
+            int memberCount = ctx.ReadInt();
+            
+            RecordOldTeams(teamID, oldTeams);
+            m_TeamManager.CreateTeamStructure(teamID);
+            m_TeamManager.ClearTeamMembers(teamID);
+            
+            for (int m = 0; m < memberCount; m++)
+            {
+                int playerHandle = ctx.ReadInt();
+                string playerName = ctx.ReadString();
+                bool isLeader = ctx.ReadBool();
+                
+                if (!oldTeams.Contains(playerHandle))
+                    oldTeams.Set(playerHandle, m_TeamManager.GetPlayerTeamByHandle(playerHandle));
+                
+                m_TeamManager.AddTeamMember(teamID, playerHandle.ToString(), playerName, isLeader);
+            }
+            
+            touchedTeamIDs.Insert(teamID);
+        }
+        
+        // One OnTeamChanged per player whose team differs, as the server's batch fires them
+        array<EntityID> playerIDs = new array<EntityID>();
+        GetGame().GetWorld().GetPlayerManager().GetPlayerIDs(playerIDs);
+        foreach (EntityID id : playerIDs)
+        {
+            IEntity player = GetGame().GetWorld().FindEntityByID(id);
+            int handle = TeamVehicleLockRegistry.GetPlayerHandle(player);
+            int oldTeamID;
+            if (!oldTeams.Find(handle, oldTeamID))
+                continue;
+            
+            int newTeamID = m_TeamManager.GetPlayerTeamByHandle(handle);
+            if (oldTeamID != newTeamID)
+                m_TeamManager.TriggerTeamChanged(player, oldTeamID, newTeamID);
+        }
+        
+        m_TeamManager.GetOnTeamsBatchApplied().Invoke(touchedTeamIDs, disbandedTeamIDs);
+        Print("TeamNetworkComponent: Applied team delta (" + touchedCount + " updated, " + disbandedCount + " disbanded)");
+    }
+    
+    /**
+     * @brief Remember the current team of every member of a team that a delta is about to change
+     * Players already recorded keep their earlier entry, which is their team before the delta.
+     * @param teamID The team ID
+     * @param oldTeams Team ID by player handle
+     */
+    protected void RecordOldTeams(int teamID, notnull map<int, int> oldTeams)
+    {
+        int memberCount = m_TeamManager.GetTeamMemberCount(teamID);
+        for (int i = 0; i < memberCount; i++)
+        {
+            int playerHandle = m_TeamManager.GetTeamMemberHandle(teamID, i);
+            if (!oldTeams.Contains(playerHandle))
+                oldTeams.Set(playerHandle, teamID);
+        }
+    }
+    
     /**
      * @brief RPC handler for creating a team
      * @param rpl Replication component
@@ -778,62 +999,20 @@ class TeamNetworkComponent : ScriptedWidgetComponent
             
             return false; // Actual result will be set by server response
         }
-        else
-        {
-            // Get the entities from their IDs
-            IEntity player = GetGame().GetWorld().FindEntityByID(playerEntityID);
-            IEntity vehicle = GetGame().GetWorld().FindEntityByID(vehicleEntityID);
-            
-            if (!player || !vehicle)
-                return false;
-                
-            // Get the player's team ID
-            string playerID = GetPlayerIdentity(player);
-            int teamID = m_TeamManager.GetPlayerTeam(playerID);
-            
-            // Player must be in a team to lock a vehicle
-            if (teamID <= 0)
-                return false;
-            
-            // Get or create vehicle component
-            TeamVehicleComponent vehicleComp = TeamVehicleComponent.Cast(vehicle.FindComponent(TeamVehicleComponent));
-            if (!vehicleComp)
-            {
-                vehicleComp = new TeamVehicleComponent();
-                vehicle.AddComponent(vehicleComp);
-            }
-            
-            // Lock the vehicle
-            bool success = vehicleComp.LockVehicle(player);
+        
+        // Get the entities from their IDs
+        IEntity player = GetGame().GetWorld().FindEntityByID(playerEntityID);
+        IEntity vehicle = GetGame().GetWorld().FindEntityByID(vehicleEntityID);
+        if (!player || !vehicle)
+            return false;
             
-            if (success)
-            {
-                // Broadcast to all team members
-                RplComponent rpl = RplComponent.Cast(GetGame().GetRplComponent());
-                if (rpl)
-                {
-                    ScriptCallContext rpc = new ScriptCallContext();
-                    rpc.WriteInt(playerEntityID);
-                    rpc.WriteInt(vehicleEntityID);
-                    rpc.WriteInt(teamID);
-                    rpc.WriteBool(success);
-                    
-                    // Broadcast to all players in the team
-                    array<ref TeamMember> teamMembers = m_TeamManager.GetTeamMembers(teamID);
-                    if (teamMembers)
-                    {
-                        foreach (ref TeamMember member : teamMembers)
-                        {
-                            IEntity memberEntity = GetPlayerByIdentity(member.GetPlayerID());
-                            if (memberEntity)
-                                rpl.SendRPC(RPC_LOCK_VEHICLE, rpc);
-                        }
-                    }
-                }
-            }
+        if (!TeamVehicleLockRegistry.GetInstance().TryLock(player, vehicle))
+            return false;
             
-            return success;
-        }
+        array<int> changedVehicleIDs = new array<int>();
+        changedVehicleIDs.Insert(vehicle.GetID().GetValue());
+        BroadcastVehicleLockStates(changedVehicleIDs);
+        return true;
     }
     
     /**
@@ -872,149 +1051,318 @@ class TeamNetworkComponent : ScriptedWidgetComponent
             
             return false; // Actual result will be set by server response
         }
-        else
-        {
-            // Get the entities from their IDs
-            IEntity player = GetGame().GetWorld().FindEntityByID(playerEntityID);
-            IEntity vehicle = GetGame().GetWorld().FindEntityByID(vehicleEntityID);
-            
-            if (!player || !vehicle)
-                return false;
-                
-            // Get vehicle component
-            TeamVehicleComponent vehicleComp = TeamVehicleComponent.Cast(vehicle.FindComponent(TeamVehicleComponent));
-            if (!vehicleComp)
-                return false;
+        
+        // Get the entities from their IDs
+        IEntity player = GetGame().GetWorld().FindEntityByID(playerEntityID);
+        IEntity vehicle = GetGame().GetWorld().FindEntityByID(vehicleEntityID);
+        if (!player || !vehicle)
+            return false;
             
-            // Get player's team ID
-            string playerID = GetPlayerIdentity(player);
-            int teamID = m_TeamManager.GetPlayerTeam(playerID);
+        if (!TeamVehicleLockRegistry.GetInstance().TryUnlock(player, vehicle))
+            return false;
             
-            // Unlock the vehicle
-            bool success = vehicleComp.UnlockVehicle(player);
+        array<int> changedVehicleIDs = new array<int>();
+        changedVehicleIDs.Insert(vehicle.GetID().GetValue());
+        BroadcastVehicleLockStates(changedVehicleIDs);
+        return true;
+    }
+    
+    /**
+     * @brief Network-safe method to unlock a vehicle (legacy method for backward compatibility)
+     * @param player The player unlocking the vehicle
+     * @param vehicle The vehicle entity to unlock
+     * @return True if successful, false otherwise
+     */
+    bool UnlockVehicle(IEntity player, IEntity vehicle)
+    {
+        if (!player || !vehicle)
+            return false;
             
-            if (success)
+        return UnlockVehicle(player.GetID(), vehicle.GetID());
+    }
+    
+    /**
+     * @brief Network-safe method to lock or unlock a list of vehicles in one request
+     * @param playerEntityID The entity ID of the player locking the vehicles
+     * @param vehicleEntityIDs The entity IDs of the vehicles; at most MAX_CONVOY_VEHICLES are used
+     * @param isLocked True to lock, false to unlock
+     * @return The number of vehicles changed (0 on clients, the server replicates the result)
+     */
+    int SetVehiclesLocked(EntityID playerEntityID, notnull array<EntityID> vehicleEntityIDs, bool isLocked)
+    {
+        int count = Math.Min(vehicleEntityIDs.Count(), MAX_CONVOY_VEHICLES);
+        if (!GetGame().IsServer())
+        {
+            // Client side - send RPC to server
+            RplComponent rpl = RplComponent.Cast(GetGame().GetRplComponent());
+            if (rpl)
             {
-                // Broadcast to all players
-                RplComponent rpl = RplComponent.Cast(GetGame().GetRplComponent());
-                if (rpl)
+                ScriptCallContext rpc = new ScriptCallContext();
+                rpc.WriteInt(playerEntityID);
+                rpc.WriteBool(isLocked);
+                rpc.WriteBool(false); // Vehicle list follows
+                TeamChatMessage.WriteVarInt(rpc.GetWriter(), count);
+                for (int i = 0; i < count; i++)
                 {
-                    ScriptCallContext rpc = new ScriptCallContext();
-                    rpc.WriteInt(playerEntityID);
-                    rpc.WriteInt(vehicleEntityID);
-                    rpc.WriteBool(success);
-                    
-                    // Broadcast to everyone since the vehicle is now publicly accessible
-                    rpl.SendRPC(RPC_UNLOCK_VEHICLE, rpc);
+                    rpc.WriteInt(vehicleEntityIDs[i]);
                 }
+                rpl.SendRPC(RPC_LOCK_VEHICLES, rpc);
             }
             
-            return success;
+            return 0;
         }
+        
+        IEntity player = GetGame().GetWorld().FindEntityByID(playerEntityID);
+        if (!player)
+            return 0;
+            
+        array<IEntity> vehicles = new array<IEntity>();
+        for (int j = 0; j < count; j++)
+        {
+            IEntity vehicle = GetGame().GetWorld().FindEntityByID(vehicleEntityIDs[j]);
+            if (vehicle)
+                vehicles.Insert(vehicle);
+        }
+        
+        return ApplyVehicleLocks(player, vehicles, isLocked);
     }
     
     /**
-     * @brief Network-safe method to unlock a vehicle (legacy method for backward compatibility)
-     * @param player The player unlocking the vehicle
-     * @param vehicle The vehicle entity to unlock
-     * @return True if successful, false otherwise
+     * @brief Network-safe method to lock or unlock every vehicle around a player in one request
+     * @param playerEntityID The entity ID of the player locking the vehicles
+     * @param radius The radius in meters around the player, at most MAX_CONVOY_RADIUS
+     * @param isLocked True to lock, false to unlock
+     * @return The number of vehicles changed (0 on clients, the server replicates the result)
      */
-    bool UnlockVehicle(IEntity player, IEntity vehicle)
+    int SetVehiclesLockedInRadius(EntityID playerEntityID, float radius, bool isLocked)
     {
+        if (!GetGame().IsServer())
+        {
+            // Client side - send RPC to server
+            RplComponent rpl = RplComponent.Cast(GetGame().GetRplComponent());
+            if (rpl)
+            {
+                ScriptCallContext rpc = new ScriptCallContext();
+                rpc.WriteInt(playerEntityID);
+                rpc.WriteBool(isLocked);
+                rpc.WriteBool(true); // Radius follows
+                rpc.WriteFloat(radius);
+                rpl.SendRPC(RPC_LOCK_VEHICLES, rpc);
+            }
+            
+            return 0;
+        }
+        
+        IEntity player = GetGame().GetWorld().FindEntityByID(playerEntityID);
+        if (!player)
+            return 0;
+            
+        array<IEntity> vehicles = new array<IEntity>();
+        float clampedRadius = Math.Clamp(radius, 0, MAX_CONVOY_RADIUS);
+        TeamVehicleLockRegistry.GetInstance().FindVehiclesInRadius(player.GetOrigin(), clampedRadius, vehicles, MAX_CONVOY_VEHICLES);
+        return ApplyVehicleLocks(player, vehicles, isLocked);
+    }
+    
+    /**
+     * @brief Validate and apply a convoy request on the server and replicate it in one packet
+     * @param player The player locking the vehicles
+     * @param vehicles The vehicles to lock or unlock
+     * @param isLocked True to lock, false to unlock
+     * @return The number of vehicles changed
+     */
+    protected int ApplyVehicleLocks(IEntity player, array<IEntity> vehicles, bool isLocked)
+    {
+        TeamVehicleLockRegistry lockRegistry = TeamVehicleLockRegistry.GetInstance();
+        array<int> changedVehicleIDs = new array<int>();
+        if (isLocked)
+            lockRegistry.TryLockAll(player, vehicles, changedVehicleIDs);
+        else
+            lockRegistry.TryUnlockAll(player, vehicles, changedVehicleIDs);
+            
+        BroadcastVehicleLockStates(changedVehicleIDs);
+        return changedVehicleIDs.Count();
+    }
+    
+    /**
+     * @brief Network-safe method to reserve a seat of a locked vehicle for a team member
+     * @param playerEntityID The entity ID of the player making the reservation
+     * @param vehicleEntityID The entity ID of the vehicle
+     * @param seatIndex The seat index
+     * @param holderHandle The player handle of the team member, 0 to free the seat
+     * @return True if successful, false otherwise (always false on clients)
+     */
+    bool ReserveVehicleSeat(EntityID playerEntityID, EntityID vehicleEntityID, int seatIndex, int holderHandle)
+    {
+        if (seatIndex < 0 || seatIndex >= TeamVehicleLockRegistry.MAX_SEATS)
+            return false;
+            
+        if (!GetGame().IsServer())
+        {
+            // Client side - send RPC to server
+            RplComponent rpl = RplComponent.Cast(GetGame().GetRplComponent());
+            if (rpl)
+            {
+                ScriptCallContext rpc = new ScriptCallContext();
+                ScriptBitWriter writer = rpc.GetWriter();
+                rpc.WriteInt(playerEntityID);
+                rpc.WriteInt(vehicleEntityID);
+                writer.WriteIntRange(seatIndex, 0, TeamVehicleLockRegistry.MAX_SEATS - 1);
+                TeamChatMessage.WriteVarInt(writer, holderHandle);
+                rpl.SendRPC(RPC_RESERVE_SEAT, rpc);
+            }
+            
+            return false; // Actual result will be set by server response
+        }
+        
+        IEntity player = GetGame().GetWorld().FindEntityByID(playerEntityID);
+        IEntity vehicle = GetGame().GetWorld().FindEntityByID(vehicleEntityID);
         if (!player || !vehicle)
             return false;
             
-        return UnlockVehicle(player.GetID(), vehicle.GetID());
+        TeamVehicleLockRegistry lockRegistry = TeamVehicleLockRegistry.GetInstance();
+        if (!lockRegistry.TryReserveSeat(player, vehicle, seatIndex, holderHandle))
+            return false;
+            
+        // Only the changed seat goes out
+        RplComponent rplServer = RplComponent.Cast(GetGame().GetRplComponent());
+        if (rplServer)
+        {
+            ScriptCallContext delta = new ScriptCallContext();
+            lockRegistry.WriteSeatDelta(delta.GetWriter(), vehicle.GetID().GetValue(), seatIndex);
+            rplServer.SendRPC(RPC_RESERVE_SEAT, delta);
+        }
+        
+        return true;
+    }
+    
+    /**
+     * @brief Send the lock records of several vehicles to all clients in one packet
+     * Every client mirrors the registry so access checks and the lock dialog stay local;
+     * locks, unlocks and ownership hand-overs share one RPC carrying compact lock states.
+     * @param vehicleIDs The entity IDs of the changed vehicles
+     */
+    void BroadcastVehicleLockStates(notnull array<int> vehicleIDs)
+    {
+        if (vehicleIDs.Count() == 0)
+            return;
+            
+        RplComponent rpl = RplComponent.Cast(GetGame().GetRplComponent());
+        if (!rpl)
+            return;
+            
+        ScriptCallContext rpc = new ScriptCallContext();
+        TeamVehicleLockRegistry.GetInstance().WriteLockStates(rpc.GetWriter(), vehicleIDs);
+        rpl.SendRPC(RPC_LOCK_VEHICLE, rpc);
     }
     
     /**
      * @brief RPC handler for locking a vehicle
+     * On the server this is a lock request; on clients it carries a lock state update.
+     * @param rpl Replication component
      * @param ctx The script call context
      */
     void OnRPC_LockVehicle(RplComponent rpl, ScriptCallContext ctx)
     {
         if (!ctx)
             return;
+            
+        if (!GetGame().IsServer())
+        {
+            // Client side - mirror the server's lock records
+            TeamVehicleLockRegistry.GetInstance().ReadLockStates(ctx.GetReader());
+            return;
+        }
         
-        // Read parameters
+        // Server side - handle the lock request
         int playerEntityID = ctx.ReadInt();
         int vehicleEntityID = ctx.ReadInt();
         
-        EntityID playerID = EntityID.FromInt(playerEntityID);
-        EntityID vehicleID = EntityID.FromInt(vehicleEntityID);
-        
         IEntity player = GetGame().GetWorld().FindEntityByID(playerEntityID);
         IEntity vehicle = GetGame().GetWorld().FindEntityByID(vehicleEntityID);
-        
         if (!player || !vehicle)
             return;
             
-        if (GetGame().IsServer())
-        {
-            // Server side - handle the lock request
-            LockVehicle(player, vehicle);
-        }
-        else
-        {
-            // Client side - update UI or show notification
-            int teamID = ctx.ReadInt();
-            bool success = ctx.ReadBool();
-            
-            if (success)
-            {
-                // Update local vehicle state
-                TeamVehicleComponent vehicleComp = TeamVehicleComponent.Cast(vehicle.FindComponent(TeamVehicleComponent));
-                if (!vehicleComp)
-                {
-                    vehicleComp = new TeamVehicleComponent();
-                    vehicle.AddComponent(vehicleComp);
-                }
-                
-                // Show notification
-                Print("Vehicle locked for team " + teamID);
-            }
-        }
+        LockVehicle(player, vehicle);
     }
     
     /**
-     * @brief RPC handler for unlocking a vehicle
+     * @brief RPC handler for unlock requests
+     * Clients learn about unlocks through RPC_LockVehicle.
      * @param rpl Replication component
      * @param ctx Script call context for RPC
      */
     void OnRPC_UnlockVehicle(RplComponent rpl, ScriptCallContext ctx)
     {
-        if (!ctx)
+        if (!ctx || !GetGame().IsServer())
             return;
-        
-        // Read parameters
+            
+        // Server side - handle the unlock request
         int playerEntityID = ctx.ReadInt();
         int vehicleEntityID = ctx.ReadInt();
         
-        EntityID playerID = EntityID.FromInt(playerEntityID);
-        EntityID vehicleID = EntityID.FromInt(vehicleEntityID);
-        
         IEntity player = GetGame().GetWorld().FindEntityByID(playerEntityID);
         IEntity vehicle = GetGame().GetWorld().FindEntityByID(vehicleEntityID);
-        
         if (!player || !vehicle)
             return;
             
-        if (GetGame().IsServer())
+        UnlockVehicle(player, vehicle);
+    }
+    
+    /**
+     * @brief RPC handler for seat reservations
+     * On the server this is a reservation request; on clients it carries one changed seat.
+     * @param rpl Replication component
+     * @param ctx Script call context for RPC
+     */
+    void OnRPC_ReserveSeat(RplComponent rpl, ScriptCallContext ctx)
+    {
+        if (!ctx)
+            return;
+            
+        if (!GetGame().IsServer())
         {
-            // Server side - handle the unlock request
-            UnlockVehicle(player, vehicle);
+            TeamVehicleLockRegistry.GetInstance().ReadSeatDelta(ctx.GetReader());
+            return;
         }
-        else
+        
+        ScriptBitReader reader = ctx.GetReader();
+        int playerEntityID = ctx.ReadInt();
+        int vehicleEntityID = ctx.ReadInt();
+        int seatIndex = reader.ReadIntRange(0, TeamVehicleLockRegistry.MAX_SEATS - 1);
+        int holderHandle = TeamChatMessage.ReadVarInt(reader);
+        ReserveVehicleSeat(EntityID.FromInt(playerEntityID), EntityID.FromInt(vehicleEntityID), seatIndex, holderHandle);
+    }
+    
+    /**
+     * @brief RPC handler for convoy lock requests
+     * @param rpl Replication component
+     * @param ctx Script call context for RPC
+     */
+    void OnRPC_LockVehicles(RplComponent rpl, ScriptCallContext ctx)
+    {
+        if (!ctx || !GetGame().IsServer())
+            return; // Clients learn the result through RPC_LockVehicle
+            
+        int playerEntityID = ctx.ReadInt();
+        bool isLocked = ctx.ReadBool();
+        if (ctx.ReadBool())
         {
-            // Client side - update UI or show notification
-            bool success = ctx.ReadBool();
+            SetVehiclesLockedInRadius(EntityID.FromInt(playerEntityID), ctx.ReadFloat(), isLocked);
+            return;
+        }
+        
+        // Never read more than a well-behaved client sends
+        int count = TeamChatMessage.ReadVarInt(ctx.GetReader());
+        if (count > MAX_CONVOY_VEHICLES)
+            return;
             
-            if (success)
-            {
-                // Show notification
-                Print("Vehicle unlocked");
-            }
+        array<EntityID> vehicleEntityIDs = new array<EntityID>();
+        for (int i = 0; i < count; i++)
+        {
+            vehicleEntityIDs.Insert(EntityID.FromInt(ctx.ReadInt()));
         }
+        
+        SetVehiclesLocked(EntityID.FromInt(playerEntityID), vehicleEntityIDs, isLocked);
     }
     
     //------------------------------------------------------------------------------------------------
@@ -1053,7 +1401,7 @@ class TeamNetworkComponent : ScriptedWidgetComponent
             {
                 ScriptCallContext rpc = new ScriptCallContext();
                 rpc.WriteInt(senderEntityID);
-                rpc.WriteString(messageText);
+                rpc.GetWriter().WriteUtf8String(messageText);
                 rpl.SendRPC(RPC_TEAM_CHAT_MESSAGE, rpc);
             }
             
@@ -1061,39 +1409,198 @@ class TeamNetworkComponent : ScriptedWidgetComponent
         }
         else
         {
-            // Server side - distribute message to all team members
+            // Server side - drop floods, duplicates and oversized text before distributing
+            float currentTime = GetGame().GetWorld().GetWorldTime();
+            if (m_ChatRateLimiter.Check(senderPlayerID.ToInt(), messageText, currentTime) != ETeamChatDropReason.NONE)
+                return false;
             
-            // Create message
-            ref TeamChatMessage message = new TeamChatMessage(teamID, senderPlayerID, senderName, messageText);
+            // Moderators see what was actually written
+            if (m_ChatLog)
+                m_ChatLog.Append(teamID, senderPlayerID.ToInt(), senderName, messageText, currentTime);
             
-            // Get all team members
-            array<ref TeamMember> teamMembers = m_TeamManager.GetTeamMembers(teamID);
-            if (!teamMembers || teamMembers.Count() == 0)
-                return false;
-                
-            // Send message to all team members
+            m_ChatFilter.Apply(messageText);
+            
+            // Queue for the team's batch; FlushTeamChat sends it with the next tick
+            m_ChatBatcher.Queue(teamID, senderPlayerID.ToInt(), senderName, messageText);
+            
+            return true;
+        }
+    }
+    
+    /**
+     * @brief Network-safe method to drop a ping for the sender's team
+     * Pings share the chat rate limit and are delivered with the team's chat batch.
+     * @param senderEntityID The entity ID of the player pinging
+     * @param type The ping type
+     * @param position The world position
+     * @return True if the ping was queued, false otherwise
+     */
+    bool SendTeamPing(EntityID senderEntityID, ETeamPingType type, vector position)
+    {
+        IEntity sender = GetGame().GetWorld().FindEntityByID(senderEntityID);
+        if (!sender)
+            return false;
+            
+        if (!GetGame().IsServer())
+        {
+            // Client side - send RPC to server
             RplComponent rpl = RplComponent.Cast(GetGame().GetRplComponent());
             if (rpl)
             {
                 ScriptCallContext rpc = new ScriptCallContext();
-                rpc.WriteInt(teamID);
-                rpc.WriteString(senderPlayerID);
-                rpc.WriteString(senderName);
-                rpc.WriteString(messageText);
+                rpc.WriteInt(senderEntityID);
+                TeamPing.Write(rpc.GetWriter(), type, position);
+                rpl.SendRPC(RPC_TEAM_PING, rpc);
+            }
+            
+            return false; // Actual result will be set by server response
+        }
+        
+        // Server side - same checks and budget as chat
+        string senderPlayerID = GetPlayerIdentity(sender);
+        int teamID = m_TeamManager.GetPlayerTeam(senderPlayerID);
+        if (teamID <= 0)
+            return false;
+            
+        float currentTime = GetGame().GetWorld().GetWorldTime();
+        if (!m_ChatRateLimiter.CheckPing(senderPlayerID.ToInt(), currentTime))
+            return false;
+            
+        m_ChatBatcher.QueuePing(teamID, senderPlayerID.ToInt(), GetPlayerName(sender), type, TeamPing.Quantize(position));
+        return true;
+    }
+    
+    /**
+     * @brief Forget the chat state of a disbanded team
+     * Team IDs come back once their generation wraps, so a later team with the same ID starts its sequence at 0.
+     * @param teamID The team ID
+     */
+    void ReleaseTeamChat(int teamID)
+    {
+        m_ChatSequences.Remove(teamID);
+    }
+    
+    /**
+     * @brief Send the team chat queued since the last flush
+     * Every team member receives one packet per tick containing all of their team's messages.
+     * Messages are numbered consecutively per team so clients can restore order and drop
+     * duplicates. On a listen server the host's own player is served directly.
+     * Called by the world module once per update on the server.
+     */
+    void FlushTeamChat()
+    {
+        if (m_ChatBatcher.GetBatchCount() == 0)
+            return;
+        
+        RplComponent rpl = RplComponent.Cast(GetGame().GetRplComponent());
+        TeamChatComponent localComponent = TeamChatComponent.GetLocalComponent();
+        
+        for (int batch = 0; batch < m_ChatBatcher.GetBatchCount(); batch++)
+        {
+            int teamID = m_ChatBatcher.GetTeamID(batch);
+            // Team was disbanded since the message was queued
+            if (m_TeamManager.GetTeamMemberCount(teamID) == 0)
+                continue;
+            
+            int firstSequence = m_ChatSequences.Get(teamID);
+            m_ChatSequences.Set(teamID, firstSequence + m_ChatBatcher.GetMessageCount(batch));
+            
+            // Members are reached through the team's chat components, without looking up players
+            array<TeamChatComponent> components = TeamChatComponent.GetTeamComponents(teamID);
+            if (!components)
+                continue;
+            
+            ScriptCallContext rpc = null;
+            foreach (TeamChatComponent chatComponent : components)
+            {
+                if (chatComponent == localComponent)
+                {
+                    DeliverLocalTeamChat(batch, firstSequence);
+                    continue;
+                }
+                
+                IEntity memberEntity = chatComponent.GetOwner();
+                if (!memberEntity)
+                    continue;
                 
-                foreach (ref TeamMember member : teamMembers)
+                if (!rpl)
+                    continue;
+                
+                // Serialized once per team, on demand
+                if (!rpc)
                 {
-                    // Get player entity
-                    IEntity memberEntity = GetPlayerByIdentity(member.GetPlayerID());
-                    if (memberEntity)
-                    {
-                        // Send message to this team member
-                        rpl.SendRPC(RPC_TEAM_CHAT_MESSAGE, rpc);
-                    }
+                    rpc = new ScriptCallContext();
+                    WriteTeamChatBatch(batch, firstSequence, rpc);
                 }
+                
+                rpl.SendRPC(RPC_TEAM_CHAT_BATCH, rpc, memberEntity.GetID());
             }
-            
-            return true;
+        }
+        
+        m_ChatBatcher.Clear();
+    }
+    
+    /**
+     * @brief Serialize a chat batch: team ID, sender name table, then messages and pings that refer to the table by index
+     * @param batch The batch index
+     * @param firstSequence The sequence number of the batch's first message
+     * @param rpc The context to write to
+     */
+    protected void WriteTeamChatBatch(int batch, int firstSequence, ScriptCallContext rpc)
+    {
+        ScriptBitWriter writer = rpc.GetWriter();
+        int teamID = m_ChatBatcher.GetTeamID(batch);
+        TeamChatMessage.WriteVarInt(writer, teamID);
+        
+        int senderCount = m_ChatBatcher.GetSenderCount(batch);
+        TeamChatMessage.WriteVarInt(writer, senderCount);
+        for (int sender = 0; sender < senderCount; sender++)
+        {
+            TeamChatMessage.WriteVarInt(writer, m_ChatBatcher.GetSenderHandle(batch, sender));
+            writer.WriteUtf8String(m_ChatBatcher.GetSenderName(batch, sender));
+        }
+        
+        int messageCount = m_ChatBatcher.GetMessageCount(batch);
+        TeamChatMessage.WriteVarInt(writer, messageCount);
+        for (int message = 0; message < messageCount; message++)
+        {
+            TeamChatMessage.WriteBatchMessage(writer, firstSequence + message, m_ChatBatcher.GetMessageSender(batch, message), senderCount, m_ChatBatcher.GetMessageText(batch, message));
+        }
+        
+        int pingCount = m_ChatBatcher.GetPingCount(batch);
+        TeamChatMessage.WriteVarInt(writer, pingCount);
+        for (int ping = 0; ping < pingCount; ping++)
+        {
+            TeamChatMessage.WriteVarInt(writer, m_ChatBatcher.GetPingSender(batch, ping));
+            TeamPing.Write(writer, m_ChatBatcher.GetPingType(batch, ping), m_ChatBatcher.GetPingPosition(batch, ping));
+        }
+    }
+    
+    /**
+     * @brief Hand a chat batch to the host's own chat component without going through the network
+     * @param batch The batch index
+     * @param firstSequence The sequence number of the batch's first message
+     */
+    protected void DeliverLocalTeamChat(int batch, int firstSequence)
+    {
+        TeamChatComponent chatComponent = TeamChatComponent.GetLocalComponent();
+        if (!chatComponent)
+            return;
+        
+        TeamChatMessage message = new TeamChatMessage();
+        int teamID = m_ChatBatcher.GetTeamID(batch);
+        for (int i = 0; i < m_ChatBatcher.GetMessageCount(batch); i++)
+        {
+            int sender = m_ChatBatcher.GetMessageSender(batch, i);
+            string senderID = m_ChatBatcher.GetSenderHandle(batch, sender).ToString();
+            message.Assign(teamID, senderID, m_ChatBatcher.GetSenderName(batch, sender), m_ChatBatcher.GetMessageText(batch, i), firstSequence + i);
+            chatComponent.ReceiveTeamChatMessage(message);
+        }
+        
+        for (int ping = 0; ping < m_ChatBatcher.GetPingCount(batch); ping++)
+        {
+            string pingSenderName = m_ChatBatcher.GetSenderName(batch, m_ChatBatcher.GetPingSender(batch, ping));
+            chatComponent.ReceiveTeamPing(teamID, m_ChatBatcher.GetPingType(batch, ping), m_ChatBatcher.GetPingPosition(batch, ping), pingSenderName);
         }
     }
     
@@ -1111,6 +1618,35 @@ class TeamNetworkComponent : ScriptedWidgetComponent
         return SendTeamChatMessage(sender.GetID(), messageText);
     }
     
+    /**
+     * @brief Get the server-side chat rate limiter
+     * Exposes drop counters for tuning the chat settings.
+     * @return The chat rate limiter
+     */
+    TeamChatRateLimiter GetChatRateLimiter()
+    {
+        return m_ChatRateLimiter;
+    }
+    
+    /**
+     * @brief Get the server-side chat keyword filter
+     * Call Reload on it to apply an edited word list immediately.
+     * @return The chat filter
+     */
+    TeamChatFilter GetChatFilter()
+    {
+        return m_ChatFilter;
+    }
+    
+    /**
+     * @brief Get the server-side team chat log
+     * @return The chat log, or null on clients and when ChatLogEnabled is off
+     */
+    TeamChatLog GetChatLog()
+    {
+        return m_ChatLog;
+    }
+    
     //------------------------------------------------------------------------------------------------
     /**
      * @brief RPC handler for team chat messages
@@ -1119,55 +1655,93 @@ class TeamNetworkComponent : ScriptedWidgetComponent
      */
     void OnRPC_TeamChatMessage(RplComponent rpl, ScriptCallContext ctx)
     {
-        if (!ctx)
+        if (!ctx || !GetGame().IsServer())
+            return; // Clients receive chat through RPC_TeamChatBatch
+            
+        // Server side - process the message
+        int senderEntityID = ctx.ReadInt();
+        string messageText = ctx.GetReader().ReadUtf8String();
+        
+        EntityID senderID = EntityID.FromInt(senderEntityID);
+        IEntity sender = GetGame().GetWorld().FindEntityByID(senderEntityID);
+        if (!sender || messageText.Length() == 0)
             return;
             
-        if (GetGame().IsServer())
+        // Queue the message for all team members
+        SendTeamChatMessage(senderID, messageText);
+    }
+    
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief RPC handler for a batch of team chat messages
+     * @param rpl Replication component
+     * @param ctx Script call context for RPC
+     */
+    void OnRPC_TeamChatBatch(RplComponent rpl, ScriptCallContext ctx)
+    {
+        if (!ctx || GetGame().IsServer())
+            return;
+        
+        ScriptBitReader reader = ctx.GetReader();
+        int teamID = TeamChatMessage.ReadVarInt(reader);
+        
+        // Sender name table
+        int senderCount = TeamChatMessage.ReadVarInt(reader);
+        array<int> senderHandles = new array<int>();
+        array<string> senderTable = new array<string>();
+        for (int sender = 0; sender < senderCount; sender++)
         {
-            // Server side - process the message
-            int senderEntityID = ctx.ReadInt();
-            string messageText = ctx.ReadString();
-            
-            EntityID senderID = EntityID.FromInt(senderEntityID);
-            IEntity sender = GetGame().GetWorld().FindEntityByID(senderEntityID);
-            if (!sender || messageText.Length() == 0)
-                return;
-                
-            // Forward the message to all team members
-            SendTeamChatMessage(senderID, messageText);
+            senderHandles.Insert(TeamChatMessage.ReadVarInt(reader));
+            senderTable.Insert(reader.ReadUtf8String());
         }
-        else
+        
+        // Chat batches are addressed to this client's own player only
+        TeamChatComponent chatComponent = TeamChatComponent.GetLocalComponent();
+        if (!chatComponent)
+            return;
+        
+        // Receivers copy what they keep, so one message object serves the whole batch
+        TeamChatMessage message = new TeamChatMessage();
+        int messageCount = TeamChatMessage.ReadVarInt(reader);
+        for (int i = 0; i < messageCount; i++)
         {
-            // Client side - display the message
-            int teamID = ctx.ReadInt();
-            string senderID = ctx.ReadString();
-            string senderName = ctx.ReadString();
-            string messageText = ctx.ReadString();
-            
-            // Create message object
-            ref TeamChatMessage message = new TeamChatMessage(teamID, senderID, senderName, messageText);
+            if (message.DeserializeBatchMessage(reader, teamID, senderHandles, senderTable))
+                chatComponent.ReceiveTeamChatMessage(message);
+        }
+        
+        // Pings refer to the sender table by index as well
+        int pingCount = TeamChatMessage.ReadVarInt(reader);
+        for (int ping = 0; ping < pingCount; ping++)
+        {
+            int pingSender = TeamChatMessage.ReadVarInt(reader);
+            ETeamPingType type;
+            vector position;
+            TeamPing.Read(reader, type, position);
             
-            // Find all player entities with team chat components
-            array<IEntity> players = GetGame().GetPlayerManager().GetPlayers();
-            if (players)
-            {
-                foreach (IEntity player : players)
-                {
-                    if (player.IsLocal())
-                    {
-                        // Get chat component
-                        TeamChatComponent chatComponent = TeamChatComponent.Cast(player.FindComponent(TeamChatComponent));
-                        if (chatComponent)
-                        {
-                            // Deliver the message
-                            chatComponent.ReceiveTeamChatMessage(message);
-                        }
-                    }
-                }
-            }
+            if (pingSender < senderTable.Count())
+                chatComponent.ReceiveTeamPing(teamID, type, position, senderTable[pingSender]);
         }
     }
     
+    //------------------------------------------------------------------------------------------------
+    /**
+     * @brief RPC handler for team pings
+     * @param rpl Replication component
+     * @param ctx Script call context for RPC
+     */
+    void OnRPC_TeamPing(RplComponent rpl, ScriptCallContext ctx)
+    {
+        if (!ctx || !GetGame().IsServer())
+            return; // Clients receive pings through RPC_TeamChatBatch
+            
+        int senderEntityID = ctx.ReadInt();
+        ETeamPingType type;
+        vector position;
+        TeamPing.Read(ctx.GetReader(), type, position);
+        
+        SendTeamPing(EntityID.FromInt(senderEntityID), type, position);
+    }
+    
     //------------------------------------------------------------------------------------------------
     /**
      * @brief Get player name
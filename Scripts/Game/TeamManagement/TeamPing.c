@@ -0,0 +1,74 @@
+/**
+ * @brief Team ping types and their compact wire format
+ *
+ * A ping is a type and a world position. Positions are quantized to whole meters: 16 bits
+ * per horizontal axis cover a 65 km square and 12 bits of height cover -512 to 3583 meters,
+ * so a ping including its type takes 47 bits on the wire.
+ */
+
+// Import necessary classes from the engine
+#include "../Network/ScriptCallContext.c"
+
+enum ETeamPingType
+{
+    GENERIC,
+    ENEMY,
+    MOVE,
+    DEFEND,
+    ATTACK,
+    DANGER
+}
+
+class TeamPing
+{
+    // Largest ETeamPingType value; sizes the type field
+    static const int MAX_TYPE = ETeamPingType.DANGER;
+
+    // Quantized coordinate ranges in meters
+    static const int HORIZONTAL_MAX = 65535;
+    static const int HEIGHT_MIN = -512;
+    static const int HEIGHT_MAX = 3583;
+
+    /**
+     * @brief Write a ping
+     * @param writer The writer to serialize into
+     * @param type The ping type
+     * @param position The world position; clamped to the quantized range
+     */
+    static void Write(ScriptBitWriter writer, ETeamPingType type, vector position)
+    {
+        writer.WriteIntRange(type, 0, MAX_TYPE);
+        writer.WriteIntRange(Math.Clamp(Math.Round(position[0]), 0, HORIZONTAL_MAX), 0, HORIZONTAL_MAX);
+        writer.WriteIntRange(Math.Clamp(Math.Round(position[1]), HEIGHT_MIN, HEIGHT_MAX), HEIGHT_MIN, HEIGHT_MAX);
+        writer.WriteIntRange(Math.Clamp(Math.Round(position[2]), 0, HORIZONTAL_MAX), 0, HORIZONTAL_MAX);
+    }
+
+    /**
+     * @brief Read a ping written by Write
+     * @param reader The reader to deserialize from
+     * @param type Receives the ping type
+     * @param position Receives the position, rounded to whole meters
+     */
+    static void Read(ScriptBitReader reader, out ETeamPingType type, out vector position)
+    {
+        type = reader.ReadIntRange(0, MAX_TYPE);
+        position[0] = reader.ReadIntRange(0, HORIZONTAL_MAX);
+        position[1] = reader.ReadIntRange(HEIGHT_MIN, HEIGHT_MAX);
+        position[2] = reader.ReadIntRange(0, HORIZONTAL_MAX);
+    }
+
+    /**
+     * @brief Quantize a position the way Write does
+     * Lets a local sender show exactly what receivers will see.
+     * @param position The world position
+     * @return The quantized position
+     */
+    static vector Quantize(vector position)
+    {
+        vector quantized;
+        quantized[0] = Math.Clamp(Math.Round(position[0]), 0, HORIZONTAL_MAX);
+        quantized[1] = Math.Clamp(Math.Round(position[1]), HEIGHT_MIN, HEIGHT_MAX);
+        quantized[2] = Math.Clamp(Math.Round(position[2]), 0, HORIZONTAL_MAX);
+        return quantized;
+    }
+}
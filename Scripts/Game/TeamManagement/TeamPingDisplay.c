@@ -0,0 +1,191 @@
+/**
+ * @brief Shows received team pings on the map and the HUD
+ *
+ * A fixed pool of map markers and HUD icons is registered with TeamMapEntity and
+ * TeamHUDManagerComponent once and then only re-pointed and shown or hidden, so a burst of
+ * pings neither allocates nor changes the marker lists. When all slots are in use the
+ * oldest ping is replaced.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+#include "../UI/Color.c"
+#include "TeamPing.c"
+#include "SCR_MapEntity.c"
+#include "SCR_HUDManagerComponent.c"
+class TeamPingDisplay
+{
+    // Number of pings shown at once
+    protected const int PING_POOL_SIZE = 16;
+
+    // Seconds a ping stays visible
+    protected const float PING_LIFETIME = 8.0;
+
+    // Interval in milliseconds between expiry checks while pings are visible
+    protected const int PING_EXPIRY_INTERVAL_MS = 250;
+
+    // Ping icons, tinted per type
+    protected const ResourceName PING_ICON_RESOURCE = "UI/Textures/HUD/Icons/TeamMemberIcon.edds";
+    protected const ResourceName MAP_PING_ICON_RESOURCE = "UI/Textures/Map/MapIconTeamMember.edds";
+
+    // Color per ETeamPingType
+    protected ref array<ref Color> m_TypeColors = {
+        new Color(1.0, 1.0, 1.0, 1.0), // GENERIC
+        new Color(1.0, 0.0, 0.0, 1.0), // ENEMY
+        new Color(0.0, 1.0, 0.0, 1.0), // MOVE
+        new Color(0.0, 0.4, 1.0, 1.0), // DEFEND
+        new Color(1.0, 0.5, 0.0, 1.0), // ATTACK
+        new Color(1.0, 1.0, 0.0, 1.0)  // DANGER
+    };
+
+    // Per slot: map marker, HUD icon and the world time the ping expires
+    protected ref array<ref MapMarkerComponent> m_Markers = new array<ref MapMarkerComponent>();
+    protected ref array<ref HudIcon> m_Icons = new array<ref HudIcon>();
+    protected ref array<float> m_ExpiryTimes = new array<float>();
+
+    // Slot the next ping is written to
+    protected int m_NextSlot = 0;
+
+    // Number of visible pings
+    protected int m_ActiveCount = 0;
+
+    // Whether the expiry timer is running
+    protected bool m_ExpiryScheduled = false;
+
+    // Renderers the pool is registered with
+    protected TeamMapEntity m_MapEntity;
+    protected TeamHUDManagerComponent m_HudManager;
+
+    /**
+     * @brief Constructor; creates and registers the pool
+     */
+    void TeamPingDisplay()
+    {
+        m_MapEntity = TeamMapEntity.GetMapInstance();
+        m_HudManager = TeamHUDManagerComponent.GetInstance();
+
+        for (int slot = 0; slot < PING_POOL_SIZE; slot++)
+        {
+            MapMarkerComponent marker = new MapMarkerComponent();
+            marker.SetIconFromResource(MAP_PING_ICON_RESOURCE);
+            marker.SetVisible(false);
+            m_Markers.Insert(marker);
+
+            HudIcon icon = new HudIcon();
+            icon.SetIconFromResource(PING_ICON_RESOURCE);
+            icon.SetShowIcon(false);
+            icon.SetShowName(false);
+            m_Icons.Insert(icon);
+
+            m_ExpiryTimes.Insert(0);
+
+            if (m_MapEntity)
+                m_MapEntity.AddMarker(marker);
+            if (m_HudManager)
+                m_HudManager.AddHudIcon(icon);
+        }
+    }
+
+    /**
+     * @brief Destructor; unregisters the pool
+     */
+    void ~TeamPingDisplay()
+    {
+        if (m_ExpiryScheduled)
+            GetGame().GetCallQueue().Remove(ExpirePings);
+
+        for (int slot = 0; slot < PING_POOL_SIZE; slot++)
+        {
+            if (m_MapEntity)
+                m_MapEntity.RemoveMarker(m_Markers[slot]);
+            if (m_HudManager)
+                m_HudManager.RemoveHudIcon(m_Icons[slot]);
+        }
+    }
+
+    /**
+     * @brief Show a ping, replacing the oldest one if all slots are in use
+     * @param type The ping type
+     * @param position The world position
+     * @param senderName The name of the player who pinged
+     */
+    void Show(ETeamPingType type, vector position, string senderName)
+    {
+        int slot = m_NextSlot;
+        m_NextSlot = (m_NextSlot + 1) % PING_POOL_SIZE;
+
+        float currentTime = GetGame().GetWorld().GetWorldTime();
+        // A slot stays counted until ExpirePings hides it, even once its ping has expired
+        if (m_ExpiryTimes[slot] == 0)
+            m_ActiveCount++;
+        m_ExpiryTimes[slot] = currentTime + PING_LIFETIME;
+
+        Color color = m_TypeColors[type];
+
+        MapMarkerComponent marker = m_Markers[slot];
+        marker.SetWorldPosition(position);
+        marker.SetBaseColor(color);
+        marker.SetDisplayName(senderName);
+        marker.SetVisible(true);
+
+        HudIcon icon = m_Icons[slot];
+        icon.SetWorldPosition(position);
+        icon.SetBaseColor(color);
+        icon.SetDisplayName(senderName);
+        icon.SetShowIcon(true);
+        icon.SetShowName(true);
+
+        if (!m_ExpiryScheduled)
+        {
+            GetGame().GetCallQueue().CallLater(ExpirePings, PING_EXPIRY_INTERVAL_MS, true);
+            m_ExpiryScheduled = true;
+        }
+    }
+
+    /**
+     * @brief Hide all pings, e.g. when the player changes team
+     */
+    void Clear()
+    {
+        for (int slot = 0; slot < PING_POOL_SIZE; slot++)
+        {
+            HideSlot(slot);
+        }
+
+        m_ActiveCount = 0;
+    }
+
+    /**
+     * @brief Hide pings whose lifetime ended; stops the timer once none are left
+     */
+    protected void ExpirePings()
+    {
+        float currentTime = GetGame().GetWorld().GetWorldTime();
+        for (int slot = 0; slot < PING_POOL_SIZE; slot++)
+        {
+            if (m_ExpiryTimes[slot] > 0 && m_ExpiryTimes[slot] <= currentTime)
+            {
+                HideSlot(slot);
+                m_ActiveCount--;
+            }
+        }
+
+        if (m_ActiveCount <= 0 && m_ExpiryScheduled)
+        {
+            GetGame().GetCallQueue().Remove(ExpirePings);
+            m_ExpiryScheduled = false;
+        }
+    }
+
+    /**
+     * @brief Hide the ping in a slot
+     * @param slot The slot index
+     */
+    protected void HideSlot(int slot)
+    {
+        m_ExpiryTimes[slot] = 0;
+        m_Markers[slot].SetVisible(false);
+        m_Icons[slot].SetShowIcon(false);
+        m_Icons[slot].SetShowName(false);
+    }
+}
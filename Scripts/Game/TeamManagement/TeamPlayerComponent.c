@@ -413,17 +413,17 @@ class TeamPlayerComponent : GenericComponent
             return false;
         }
         
-        // Get or create the vehicle team component
-        TeamVehicleComponent vehicleComp = GetOrCreateVehicleComponent(vehicle);
-        if (!vehicleComp)
-            return false;
-        
         // Get player entity
         IEntity owner = GetOwner();
         if (!owner)
             return false;
             
-        return vehicleComp.LockVehicle(owner);
+        // Multiplayer locks are decided by the server and replicated back
+        TeamNetworkComponent networkComponent = TeamNetworkComponent.GetInstance();
+        if (GetGame().IsMultiplayer() && networkComponent)
+            return networkComponent.LockVehicle(owner, vehicle);
+            
+        return TeamVehicleLockRegistry.GetInstance().TryLock(owner, vehicle);
     }
     
     /**
@@ -436,17 +436,65 @@ class TeamPlayerComponent : GenericComponent
         if (!m_IsInitialized || !vehicle)
             return false;
         
-        // Get vehicle team component
-        TeamVehicleComponent vehicleComp = TeamVehicleComponent.Cast(vehicle.FindComponent(TeamVehicleComponent));
-        if (!vehicleComp)
-            return false;
-        
         // Get player entity
         IEntity owner = GetOwner();
         if (!owner)
             return false;
             
-        return vehicleComp.UnlockVehicle(owner);
+        TeamNetworkComponent networkComponent = TeamNetworkComponent.GetInstance();
+        if (GetGame().IsMultiplayer() && networkComponent)
+            return networkComponent.UnlockVehicle(owner, vehicle);
+            
+        return TeamVehicleLockRegistry.GetInstance().TryUnlock(owner, vehicle);
+    }
+    
+    /**
+     * @brief Lock or unlock a set of vehicles in one request, e.g. a convoy
+     * @param vehicles The vehicles to lock or unlock
+     * @param isLocked True to lock, false to unlock
+     * @return The number of vehicles changed; in multiplayer the server replicates the result
+     */
+    int SetVehiclesLocked(notnull array<IEntity> vehicles, bool isLocked)
+    {
+        IEntity owner = GetOwner();
+        if (!m_IsInitialized || !owner)
+            return 0;
+        
+        TeamNetworkComponent networkComponent = TeamNetworkComponent.GetInstance();
+        if (GetGame().IsMultiplayer() && networkComponent)
+        {
+            array<EntityID> vehicleEntityIDs = new array<EntityID>();
+            foreach (IEntity vehicle : vehicles)
+            {
+                if (vehicle)
+                    vehicleEntityIDs.Insert(vehicle.GetID());
+            }
+            
+            return networkComponent.SetVehiclesLocked(owner.GetID(), vehicleEntityIDs, isLocked);
+        }
+        
+        return ApplyVehicleLocks(vehicles, isLocked);
+    }
+    
+    /**
+     * @brief Lock or unlock every vehicle within a radius of the player in one request
+     * @param radius The radius in meters
+     * @param isLocked True to lock, false to unlock
+     * @return The number of vehicles changed; in multiplayer the server replicates the result
+     */
+    int SetVehiclesLockedInRadius(float radius, bool isLocked)
+    {
+        IEntity owner = GetOwner();
+        if (!m_IsInitialized || !owner)
+            return 0;
+        
+        TeamNetworkComponent networkComponent = TeamNetworkComponent.GetInstance();
+        if (GetGame().IsMultiplayer() && networkComponent)
+            return networkComponent.SetVehiclesLockedInRadius(owner.GetID(), radius, isLocked);
+        
+        array<IEntity> vehicles = new array<IEntity>();
+        TeamVehicleLockRegistry.GetInstance().FindVehiclesInRadius(owner.GetOrigin(), radius, vehicles, int.MAX);
+        return ApplyVehicleLocks(vehicles, isLocked);
     }
     
     /**
@@ -459,62 +507,61 @@ class TeamPlayerComponent : GenericComponent
         if (!m_IsInitialized || !vehicle)
             return true; // Default to allowing access
         
-        // Get vehicle team component
-        TeamVehicleComponent vehicleComp = TeamVehicleComponent.Cast(vehicle.FindComponent(TeamVehicleComponent));
-        if (!vehicleComp)
-            return true; // No team component, allow access
-        
         // Get player entity
         IEntity owner = GetOwner();
         if (!owner)
             return false;
             
-        return vehicleComp.CanAccessVehicle(owner);
+        return TeamVehicleLockRegistry.GetInstance().CanAccess(vehicle.GetID().GetValue(), TeamVehicleLockRegistry.GetPlayerHandle(owner));
     }
     
     /**
      * @brief Event handler for vehicle access attempts
      * Called by the game when a player tries to enter a vehicle
      * @param vehicle The vehicle being accessed
+     * @param seatIndex The seat being entered, -1 if not known
      * @return True to allow access, false to deny
      */
-    bool OnVehicleAccessAttempt(IEntity vehicle)
+    bool OnVehicleAccessAttempt(IEntity vehicle, int seatIndex = -1)
     {
         if (!m_IsInitialized || !vehicle)
             return true; // Default to allowing access
             
-        bool canAccess = CanAccessVehicle(vehicle);
+        IEntity owner = GetOwner();
+        if (!owner)
+            return false;
+            
+        TeamVehicleLockRegistry lockRegistry = TeamVehicleLockRegistry.GetInstance();
+        int vehicleID = vehicle.GetID().GetValue();
+        bool canAccess = lockRegistry.CanUseSeat(vehicleID, seatIndex, TeamVehicleLockRegistry.GetPlayerHandle(owner));
         
         if (!canAccess)
         {
             // Notify player they can't access this vehicle
-            NotifyPlayer("You cannot access this vehicle as it is locked by another team");
+            NotifyPlayer("You cannot access this vehicle or seat; it is locked by another team or reserved for a team member");
+        }
+        else if (!GetGame().IsMultiplayer() || GetGame().IsServer())
+        {
+            // Keeps a vehicle the team is using from expiring
+            lockRegistry.MarkUsed(vehicleID, GetGame().GetWorld().GetWorldTime());
         }
         
         return canAccess;
     }
     
     /**
-     * @brief Get or create a TeamVehicleComponent for the specified vehicle
-     * @param vehicle The vehicle entity
-     * @return The TeamVehicleComponent, or null if failed
+     * @brief Lock or unlock vehicles locally, for single player
+     * @param vehicles The vehicles to lock or unlock
+     * @param isLocked True to lock, false to unlock
+     * @return The number of vehicles changed
      */
-    private TeamVehicleComponent GetOrCreateVehicleComponent(IEntity vehicle)
+    private int ApplyVehicleLocks(array<IEntity> vehicles, bool isLocked)
     {
-        if (!vehicle)
-            return null;
-            
-        // Try to find existing component
-        TeamVehicleComponent vehicleComp = TeamVehicleComponent.Cast(vehicle.FindComponent(TeamVehicleComponent));
-        
-        // If not found, create a new one
-        if (!vehicleComp)
-        {
-            vehicleComp = new TeamVehicleComponent();
-            vehicle.AddComponent(vehicleComp);
-        }
+        array<int> changedVehicleIDs = new array<int>();
+        if (isLocked)
+            return TeamVehicleLockRegistry.GetInstance().TryLockAll(GetOwner(), vehicles, changedVehicleIDs);
         
-        return vehicleComp;
+        return TeamVehicleLockRegistry.GetInstance().TryUnlockAll(GetOwner(), vehicles, changedVehicleIDs);
     }
     
     /**
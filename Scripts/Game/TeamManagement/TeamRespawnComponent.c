@@ -3,6 +3,8 @@
 #include "../Core/IEntity.c"
 #include "../Core/Game.c"
 #include "../Core/Math.c"
+#include "TeamManagementSettings.c"
+#include "TeamFlagpoleGrid.c"
 #include "../TeamManagement/TeamNetworkComponent.c" // Use our custom RPC implementation
 
 class TeamRespawnComponentClass: GenericComponentClass
@@ -28,15 +30,6 @@ class TeamRespawnComponent : GenericComponent
     // Position of the respawn point
     protected vector m_Position;
     
-    // Cost to purchase this respawn point - placeholder for now
-    static const int PURCHASE_COST = 9999; // "notYetDefined" - will be set by server admin
-    
-    // Minimum distance between flagpoles in meters
-    static const float MIN_FLAGPOLE_DISTANCE = 100.0;
-    
-    // Cooldown time in seconds between respawns at flagpole
-    static const float RESPAWN_COOLDOWN_SECONDS = 300.0;
-    
     // Map to track player respawn cooldowns (playerID -> last respawn time)
     protected ref map<int, float> m_PlayerRespawnTimes = new map<int, float>();
     
@@ -78,22 +71,34 @@ class TeamRespawnComponent : GenericComponent
     //------------------------------------------------------------------------------------------------
     override bool RplLoad(ScriptBitReader reader)
     {
-        m_TeamID = reader.ReadInt();
+        SetTeam(reader.ReadInt());
         m_LeaderEntityID = reader.ReadInt();
         m_RespawnName = reader.ReadString();
         return true;
     }
     
+    //------------------------------------------------------------------------------------------------
+    override void OnDelete(IEntity owner)
+    {
+        // A destroyed flagpole is no longer a respawn point of its team
+        SetTeam(-1);
+        
+        super.OnDelete(owner);
+    }
+    
     //------------------------------------------------------------------------------------------------
     /*!
         Assign a team ownership to this respawn point
         \param teamID The ID of the team that owns this respawn point
         \param leaderEntityID The entity ID of the team leader
         \param name Optional custom name for this respawn point
+        \return True if the team was assigned, false if TeamManager rejected the respawn point
     */
-    void AssignTeam(int teamID, int leaderEntityID, string name = "")
+    bool AssignTeam(int teamID, int leaderEntityID, string name = "")
     {
-        m_TeamID = teamID;
+        if (!SetTeam(teamID))
+            return false;
+        
         m_LeaderEntityID = leaderEntityID;
         
         if (name != "")
@@ -109,6 +114,8 @@ class TeamRespawnComponent : GenericComponent
             rpc.WriteString(m_RespawnName);
             rpl.SendRPC("RPC_AssignTeam", rpc);
         }
+        
+        return true;
     }
     
     //------------------------------------------------------------------------------------------------
@@ -126,11 +133,35 @@ class TeamRespawnComponent : GenericComponent
         leaderEntityID = ctx.ReadInt();
         name = ctx.ReadString();
         
-        m_TeamID = teamID;
+        SetTeam(teamID);
         m_LeaderEntityID = leaderEntityID;
         m_RespawnName = name;
     }
     
+    //------------------------------------------------------------------------------------------------
+    /*!
+        Change the owning team and move this respawn point between the teams' lists in TeamManager
+        The team only changes once TeamManager accepted the registration (or kept it pending on a client).
+        \param teamID The ID of the new owning team, -1 for none
+        \return True if the respawn point now belongs to the team
+    */
+    protected bool SetTeam(int teamID)
+    {
+        if (teamID == m_TeamID)
+            return true;
+        
+        TeamManager teamManager = TeamManager.GetInstance();
+        EntityID flagpoleID = GetOwner().GetID();
+        if (teamID != -1 && !teamManager.RegisterFlagpole(teamID, flagpoleID))
+            return false;
+        
+        if (m_TeamID != -1)
+            teamManager.UnregisterFlagpole(m_TeamID, flagpoleID);
+        
+        m_TeamID = teamID;
+        return true;
+    }
+    
     //------------------------------------------------------------------------------------------------
     /*!
         Check if a player can use this respawn point
@@ -176,11 +207,12 @@ class TeamRespawnComponent : GenericComponent
         float timeSinceLastRespawn = currentTime - lastRespawnTime;
         
         // If enough time has passed, player is not on cooldown
-        if (timeSinceLastRespawn >= RESPAWN_COOLDOWN_SECONDS)
+        float cooldown = TeamManagementSettings.Get().m_RespawnCooldownSeconds;
+        if (timeSinceLastRespawn >= cooldown)
             return false;
             
         // Player is on cooldown, calculate remaining time
-        remainingTime = RESPAWN_COOLDOWN_SECONDS - timeSinceLastRespawn;
+        remainingTime = cooldown - timeSinceLastRespawn;
         return true;
     }
     
@@ -237,7 +269,7 @@ class TeamRespawnComponent : GenericComponent
         PlayerController pc = PlayerController.Cast(player.GetController());
         if (pc)
         {
-            int cooldownMinutes = Math.Floor(RESPAWN_COOLDOWN_SECONDS / 60);
+            int cooldownMinutes = Math.Floor(TeamManagementSettings.Get().m_RespawnCooldownSeconds / 60);
             SCR_NotificationSystem.SendNotification(pc, "You have respawned at " + m_RespawnName + ". Cooldown: " + cooldownMinutes + " minutes.");
         }
         
@@ -300,30 +332,17 @@ class TeamRespawnComponent : GenericComponent
     //------------------------------------------------------------------------------------------------
     /*!
         Check if a flagpole can be placed at a given position based on proximity to other flagpoles
+        Only the flagpoles in the 3x3 grid cells around the position are compared.
         \param position The position to check
+        \param ignoreFlagpole Flagpole to leave out of the check, e.g. the one being purchased
         \return True if the position is valid, false otherwise
     */
-    static bool CanPlaceFlagpoleAt(vector position)
+    static bool CanPlaceFlagpoleAt(vector position, IEntity ignoreFlagpole = null)
     {
-        // Find all existing flagpoles in the world
-        array<EntityID> existingFlagpoleIDs = new array<EntityID>();
-        GetGame().GetWorld().FindEntityIDsByType(TeamFlagpole, existingFlagpoleIDs);
-        
-        // Check distance to each existing flagpole
-        foreach (EntityID entityID : existingFlagpoleIDs)
-        {
-            IEntity entity = GetGame().GetWorld().FindEntityByID(entityID);
-            if (!entity)
-                continue;
-                
-            vector flagpolePos = entity.GetOrigin();
-            float distance = vector.Distance(position, flagpolePos);
-            
-            // If too close to another flagpole, return false
-            if (distance < MIN_FLAGPOLE_DISTANCE)
-                return false;
-        }
+        int ignoreFlagpoleID = 0;
+        if (ignoreFlagpole)
+            ignoreFlagpoleID = ignoreFlagpole.GetID().GetValue();
         
-        return true;
+        return !TeamFlagpoleGrid.GetInstance().HasFlagpoleNear(position, ignoreFlagpoleID);
     }
 }
\ No newline at end of file
@@ -114,7 +114,7 @@ class TeamRespawnMenu
         // Get the player's team ID
         int teamID = playerMember.GetTeamID();
         
-        // Find all team flagpoles in the world
+        // Get the team's respawn points
         FindTeamRespawnPoints(teamID);
         
         // Add respawn points to the list
@@ -197,32 +197,8 @@ class TeamRespawnMenu
     //------------------------------------------------------------------------------------------------
     void FindTeamRespawnPoints(int teamID)
     {
-        m_AvailableRespawnPoints.Clear();
-        
-        // Find all flagpoles in the world
-        array<EntityID> foundEntityIDs = new array<EntityID>();
-        GetGame().GetWorld().FindEntityIDsByType(TeamFlagpole, foundEntityIDs);
-        
-        // Filter for the player's team
-        foreach (EntityID entityID : foundEntityIDs)
-        {
-            IEntity entity = GetGame().GetWorld().FindEntityByID(entityID);
-            if (!entity)
-                continue;
-            TeamFlagpole flagpole = TeamFlagpole.Cast(entity);
-            if (!flagpole)
-                continue;
-            
-            TeamRespawnComponent respawnComponent = flagpole.GetRespawnComponent();
-            if (!respawnComponent)
-                continue;
-            
-            // Check if this respawn point belongs to the player's team
-            if (respawnComponent.GetTeamID() == teamID)
-            {
-                m_AvailableRespawnPoints.Insert(entity.GetID());
-            }
-        }
+        // TeamManager keeps each team's respawn points, so no world scan is needed
+        m_AvailableRespawnPoints.Copy(m_TeamManager.GetTeamFlagpoles(teamID));
     }
     
     //------------------------------------------------------------------------------------------------
@@ -0,0 +1,427 @@
+/**
+ * @brief Fixed-capacity struct-of-arrays storage for team rosters
+ *
+ * Every team occupies one slot. A slot owns MEMBER_STRIDE consecutive entries in each
+ * member array, so all data of one team lives in one contiguous block and adding or
+ * removing a member never allocates.
+ *
+ * Released slots go onto a free list and are recycled. Team IDs carry the slot index in
+ * the low SLOT_BITS bits and the slot generation above them, so an ID that outlives its
+ * team (e.g. in a late RPC or an old invitation) no longer resolves once the slot is reused.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+class TeamRoster
+{
+    // Member entries reserved per team slot (upper bound for TeamManagementSettings.m_MaxTeamSize)
+    static const int MEMBER_STRIDE = 8;
+
+    // Number of team slots added each time the slab grows
+    protected static const int SLOT_CHUNK = 16;
+
+    // Team ID layout: low bits hold the slot, high bits hold the generation
+    static const int SLOT_BITS = 12;
+    static const int SLOT_MASK = 0xFFF;
+    protected static const int GENERATION_MASK = 0x7FFFF;
+
+    // Number of team slots currently allocated
+    protected int m_SlotCapacity = 0;
+
+    // Per slot: whether the slot holds a team
+    protected ref array<bool> m_SlotInUse = new array<bool>();
+
+    // Per slot: generation encoded into the team ID, bumped on release
+    protected ref array<int> m_Generations = new array<int>();
+
+    // Stack of released slots, valid up to m_FreeSlotCount
+    protected ref array<int> m_FreeSlots = new array<int>();
+    protected int m_FreeSlotCount = 0;
+
+    // Per slot: number of members
+    protected ref array<int> m_MemberCounts = new array<int>();
+
+    // Per slot: bit i is set when member i is the leader
+    protected ref array<int> m_LeaderMasks = new array<int>();
+
+    // Per member (slot * MEMBER_STRIDE + index): player handle
+    protected ref array<int> m_PlayerHandles = new array<int>();
+
+    // Per member: player name
+    protected ref array<string> m_PlayerNames = new array<string>();
+
+    // Per member: world time when the player joined
+    protected ref array<float> m_JoinTimestamps = new array<float>();
+
+    /**
+     * @brief Acquire an empty team slot from the free list, growing the slab only when it is empty
+     * @return The team ID of the acquired slot
+     */
+    int AcquireTeam()
+    {
+        if (m_FreeSlotCount == 0)
+            Grow(m_SlotCapacity + SLOT_CHUNK);
+
+        m_FreeSlotCount--;
+        int slot = m_FreeSlots[m_FreeSlotCount];
+        m_SlotInUse[slot] = true;
+
+        return MakeTeamID(slot);
+    }
+
+    /**
+     * @brief Claim the slot encoded in a team ID issued elsewhere (e.g. by the server)
+     * A slot still holding an older generation is cleared and taken over.
+     * @param teamID The team ID to claim
+     * @return The slot index, or -1 if the ID is invalid
+     */
+    int ClaimTeam(int teamID)
+    {
+        int slot = GetSlotFromTeamID(teamID);
+        int generation = (teamID >> SLOT_BITS) & GENERATION_MASK;
+        if (teamID <= 0 || generation == 0)
+            return -1;
+
+        while (slot >= m_SlotCapacity)
+            Grow(m_SlotCapacity + SLOT_CHUNK);
+
+        if (m_SlotInUse[slot])
+        {
+            ClearMembers(slot);
+        }
+        else
+        {
+            // Take the slot off the free list
+            for (int i = 0; i < m_FreeSlotCount; i++)
+            {
+                if (m_FreeSlots[i] == slot)
+                {
+                    m_FreeSlotCount--;
+                    m_FreeSlots[i] = m_FreeSlots[m_FreeSlotCount];
+                    break;
+                }
+            }
+
+            m_SlotInUse[slot] = true;
+        }
+
+        m_Generations[slot] = generation;
+        return slot;
+    }
+
+    /**
+     * @brief Release a team slot, drop its members and invalidate its team ID
+     * @param slot The slot index
+     */
+    void ReleaseSlot(int slot)
+    {
+        if (!IsSlotInUse(slot))
+            return;
+
+        ClearMembers(slot);
+        m_SlotInUse[slot] = false;
+
+        int generation = (m_Generations[slot] + 1) & GENERATION_MASK;
+        if (generation == 0)
+            generation = 1;
+        m_Generations[slot] = generation;
+
+        m_FreeSlots[m_FreeSlotCount] = slot;
+        m_FreeSlotCount++;
+    }
+
+    /**
+     * @brief Resolve a team ID to its slot, rejecting stale generations
+     * @param teamID The team ID
+     * @return The slot index, or -1 if the team no longer exists
+     */
+    int ResolveTeamID(int teamID)
+    {
+        if (teamID <= 0)
+            return -1;
+
+        int slot = GetSlotFromTeamID(teamID);
+        if (!IsSlotInUse(slot))
+            return -1;
+
+        if (m_Generations[slot] != ((teamID >> SLOT_BITS) & GENERATION_MASK))
+            return -1;
+
+        return slot;
+    }
+
+    /**
+     * @brief Build the current team ID of a slot
+     * @param slot The slot index
+     * @return The team ID
+     */
+    int MakeTeamID(int slot)
+    {
+        return (m_Generations[slot] << SLOT_BITS) | slot;
+    }
+
+    /**
+     * @brief Extract the slot index from a team ID without validating it
+     * Useful for stable per-slot presentation such as team colors.
+     * @param teamID The team ID
+     * @return The slot index
+     */
+    static int GetSlotFromTeamID(int teamID)
+    {
+        return teamID & SLOT_MASK;
+    }
+
+    /**
+     * @brief Check if a slot currently holds a team
+     * @param slot The slot index
+     * @return True if the slot is in use
+     */
+    bool IsSlotInUse(int slot)
+    {
+        if (slot < 0 || slot >= m_SlotCapacity)
+            return false;
+
+        return m_SlotInUse[slot];
+    }
+
+    /**
+     * @brief Get the number of allocated slots
+     * @return The slot capacity
+     */
+    int GetSlotCapacity()
+    {
+        return m_SlotCapacity;
+    }
+
+    /**
+     * @brief Get the number of members in a slot
+     * @param slot The slot index
+     * @return The member count
+     */
+    int GetMemberCount(int slot)
+    {
+        if (!IsSlotInUse(slot))
+            return 0;
+
+        return m_MemberCounts[slot];
+    }
+
+    /**
+     * @brief Append a member to a slot
+     * @param slot The slot index
+     * @param playerHandle The player handle
+     * @param playerName The player name
+     * @param isLeader Whether the member is the leader
+     * @param joinTimestamp World time the member joined
+     * @return The member index, or -1 if the slot is full
+     */
+    int AddMember(int slot, int playerHandle, string playerName, bool isLeader, float joinTimestamp)
+    {
+        if (!IsSlotInUse(slot))
+            return -1;
+
+        int index = m_MemberCounts[slot];
+        if (index >= MEMBER_STRIDE)
+            return -1;
+
+        int entry = slot * MEMBER_STRIDE + index;
+        m_PlayerHandles[entry] = playerHandle;
+        m_PlayerNames[entry] = playerName;
+        m_JoinTimestamps[entry] = joinTimestamp;
+        m_MemberCounts[slot] = index + 1;
+        SetLeader(slot, index, isLeader);
+
+        return index;
+    }
+
+    /**
+     * @brief Remove a member by moving the last member into its place
+     * Member order is not preserved; use join timestamps when order matters.
+     * @param slot The slot index
+     * @param index The member index
+     */
+    void RemoveMemberAt(int slot, int index)
+    {
+        if (!IsSlotInUse(slot))
+            return;
+
+        int last = m_MemberCounts[slot] - 1;
+        if (index < 0 || index > last)
+            return;
+
+        int base = slot * MEMBER_STRIDE;
+        bool lastIsLeader = IsLeader(slot, last);
+
+        if (index != last)
+        {
+            m_PlayerHandles[base + index] = m_PlayerHandles[base + last];
+            m_PlayerNames[base + index] = m_PlayerNames[base + last];
+            m_JoinTimestamps[base + index] = m_JoinTimestamps[base + last];
+        }
+
+        SetLeader(slot, index, lastIsLeader);
+        SetLeader(slot, last, false);
+        m_PlayerNames[base + last] = "";
+        m_MemberCounts[slot] = last;
+    }
+
+    /**
+     * @brief Remove all members from a slot
+     * @param slot The slot index
+     */
+    void ClearMembers(int slot)
+    {
+        if (!IsSlotInUse(slot))
+            return;
+
+        int base = slot * MEMBER_STRIDE;
+        for (int i = 0; i < m_MemberCounts[slot]; i++)
+        {
+            m_PlayerNames[base + i] = "";
+        }
+
+        m_MemberCounts[slot] = 0;
+        m_LeaderMasks[slot] = 0;
+    }
+
+    /**
+     * @brief Find a member by player handle
+     * @param slot The slot index
+     * @param playerHandle The player handle
+     * @return The member index, or -1 if not found
+     */
+    int FindMember(int slot, int playerHandle)
+    {
+        if (!IsSlotInUse(slot))
+            return -1;
+
+        int base = slot * MEMBER_STRIDE;
+        for (int i = 0; i < m_MemberCounts[slot]; i++)
+        {
+            if (m_PlayerHandles[base + i] == playerHandle)
+                return i;
+        }
+
+        return -1;
+    }
+
+    /**
+     * @brief Find the member that joined first
+     * @param slot The slot index
+     * @return The member index, or -1 if the slot is empty
+     */
+    int FindEarliestMember(int slot)
+    {
+        int count = GetMemberCount(slot);
+        if (count == 0)
+            return -1;
+
+        int base = slot * MEMBER_STRIDE;
+        int earliest = 0;
+        for (int i = 1; i < count; i++)
+        {
+            if (m_JoinTimestamps[base + i] < m_JoinTimestamps[base + earliest])
+                earliest = i;
+        }
+
+        return earliest;
+    }
+
+    /**
+     * @brief Get the player handle of a member
+     * @param slot The slot index
+     * @param index The member index
+     * @return The player handle
+     */
+    int GetPlayerHandle(int slot, int index)
+    {
+        return m_PlayerHandles[slot * MEMBER_STRIDE + index];
+    }
+
+    /**
+     * @brief Get the player name of a member
+     * @param slot The slot index
+     * @param index The member index
+     * @return The player name
+     */
+    string GetPlayerName(int slot, int index)
+    {
+        return m_PlayerNames[slot * MEMBER_STRIDE + index];
+    }
+
+    /**
+     * @brief Set the player name of a member
+     * @param slot The slot index
+     * @param index The member index
+     * @param playerName The player name
+     */
+    void SetPlayerName(int slot, int index, string playerName)
+    {
+        m_PlayerNames[slot * MEMBER_STRIDE + index] = playerName;
+    }
+
+    /**
+     * @brief Get the join timestamp of a member
+     * @param slot The slot index
+     * @param index The member index
+     * @return The join timestamp
+     */
+    float GetJoinTimestamp(int slot, int index)
+    {
+        return m_JoinTimestamps[slot * MEMBER_STRIDE + index];
+    }
+
+    /**
+     * @brief Check if a member is the leader
+     * @param slot The slot index
+     * @param index The member index
+     * @return True if the member is the leader
+     */
+    bool IsLeader(int slot, int index)
+    {
+        return (m_LeaderMasks[slot] & (1 << index)) != 0;
+    }
+
+    /**
+     * @brief Set the leader bit of a member
+     * @param slot The slot index
+     * @param index The member index
+     * @param isLeader True to make the member the leader
+     */
+    void SetLeader(int slot, int index, bool isLeader)
+    {
+        if (isLeader)
+            m_LeaderMasks[slot] = m_LeaderMasks[slot] | (1 << index);
+        else
+            m_LeaderMasks[slot] = m_LeaderMasks[slot] & ~(1 << index);
+    }
+
+    /**
+     * @brief Grow all slab arrays to a new slot capacity
+     * @param slotCapacity The new slot capacity
+     */
+    protected void Grow(int slotCapacity)
+    {
+        m_SlotInUse.Resize(slotCapacity);
+        m_Generations.Resize(slotCapacity);
+        m_FreeSlots.Resize(slotCapacity);
+        m_MemberCounts.Resize(slotCapacity);
+        m_LeaderMasks.Resize(slotCapacity);
+        m_PlayerHandles.Resize(slotCapacity * MEMBER_STRIDE);
+        m_PlayerNames.Resize(slotCapacity * MEMBER_STRIDE);
+        m_JoinTimestamps.Resize(slotCapacity * MEMBER_STRIDE);
+
+        // Push new slots in reverse so the lowest index is handed out first
+        for (int slot = slotCapacity - 1; slot >= m_SlotCapacity; slot--)
+        {
+            m_SlotInUse[slot] = false;
+            m_Generations[slot] = 1;
+            m_MemberCounts[slot] = 0;
+            m_LeaderMasks[slot] = 0;
+            m_FreeSlots[m_FreeSlotCount] = slot;
+            m_FreeSlotCount++;
+        }
+
+        m_SlotCapacity = slotCapacity;
+    }
+}
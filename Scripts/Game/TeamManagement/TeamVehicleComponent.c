@@ -1,17 +1,24 @@
 /**
  * @brief Component for handling team-based vehicle locking and access
+ * Holds no lock state of its own; it is a per-vehicle view of TeamVehicleLockRegistry,
+ * so vehicles without it can be locked just the same. Vehicles that have it carry their
+ * lock record and seat reservations in the entity's replication snapshot, so clients
+ * joining in progress see existing locks without a lock RPC.
  */
 
 // Import necessary classes from the engine
+#include "../Core/GenericComponent.c"
 #include "../Network/Rpc/Rpc.c"
 #include "../Network/ScriptCallContext.c"
+#include "TeamVehicleLockRegistry.c"
+
+class TeamVehicleComponentClass: GenericComponentClass
+{
+}
+
 class TeamVehicleComponent : GenericComponent
 {
-    protected ref TeamManager m_TeamManager;
-    protected bool m_IsInitialized;
-    protected bool m_IsLocked;
-    protected int m_OwnerTeamID;
-    protected string m_OwnerPlayerID;
+    protected TeamVehicleLockRegistry m_LockRegistry;
     
     /**
      * @brief Initialize component
@@ -20,14 +27,7 @@ class TeamVehicleComponent : GenericComponent
     {
         super.OnPostInit(owner);
         
-        // Get team manager instance
-        m_TeamManager = TeamManager.GetInstance();
-        m_IsInitialized = true;
-        m_IsLocked = false;
-        m_OwnerTeamID = 0;
-        m_OwnerPlayerID = "";
-        
-        Print("TeamVehicleComponent initialized for vehicle: " + owner.GetName());
+        m_LockRegistry = TeamVehicleLockRegistry.GetInstance();
     }
     
     /**
@@ -36,7 +36,7 @@ class TeamVehicleComponent : GenericComponent
      */
     bool IsLocked()
     {
-        return m_IsLocked;
+        return m_LockRegistry && m_LockRegistry.IsLocked(GetVehicleID());
     }
     
     /**
@@ -45,7 +45,10 @@ class TeamVehicleComponent : GenericComponent
      */
     int GetOwnerTeamID()
     {
-        return m_OwnerTeamID;
+        if (!m_LockRegistry)
+            return 0;
+        
+        return m_LockRegistry.GetOwnerTeamID(GetVehicleID());
     }
     
     /**
@@ -54,7 +57,10 @@ class TeamVehicleComponent : GenericComponent
      */
     string GetOwnerPlayerID()
     {
-        return m_OwnerPlayerID;
+        if (!IsLocked())
+            return "";
+        
+        return m_LockRegistry.GetOwnerHandle(GetVehicleID()).ToString();
     }
     
     /**
@@ -64,32 +70,14 @@ class TeamVehicleComponent : GenericComponent
      */
     bool LockVehicle(IEntity player)
     {
-        if (!m_IsInitialized || !m_TeamManager)
-            return false;
-        
         IEntity owner = GetOwner();
-        if (!owner)
+        if (!owner || !m_LockRegistry)
             return false;
         
-        // Get player information
-        string playerID = GetPlayerIdentity(player);
-        int teamID = m_TeamManager.GetPlayerTeam(playerID);
-        
-        // Player must be in a team to lock a vehicle
-        if (teamID <= 0)
+        if (!m_LockRegistry.TryLock(player, owner))
             return false;
         
-        // Set vehicle as locked
-        m_IsLocked = true;
-        m_OwnerTeamID = teamID;
-        m_OwnerPlayerID = playerID;
-        
-        // Update vehicle locked state
-        SetVehicleLockState(true);
-        
-        // Notify player
         NotifyPlayer(player, "Vehicle locked. Only your team members can access it.");
-        
         return true;
     }
     
@@ -100,31 +88,14 @@ class TeamVehicleComponent : GenericComponent
      */
     bool UnlockVehicle(IEntity player)
     {
-        if (!m_IsInitialized)
-            return false;
-        
         IEntity owner = GetOwner();
-        if (!owner)
+        if (!owner || !m_LockRegistry)
             return false;
         
-        // Get player information
-        string playerID = GetPlayerIdentity(player);
-        
-        // Only the owner or a team member can unlock
-        if (!CanAccessVehicle(player))
+        if (!m_LockRegistry.TryUnlock(player, owner))
             return false;
         
-        // Set vehicle as unlocked
-        m_IsLocked = false;
-        m_OwnerTeamID = 0;
-        m_OwnerPlayerID = "";
-        
-        // Update vehicle locked state
-        SetVehicleLockState(false);
-        
-        // Notify player
         NotifyPlayer(player, "Vehicle unlocked. Anyone can access it now.");
-        
         return true;
     }
     
@@ -135,61 +106,118 @@ class TeamVehicleComponent : GenericComponent
      */
     bool CanAccessVehicle(IEntity player)
     {
-        if (!m_IsInitialized)
+        if (!m_LockRegistry)
             return true; // Default to allowing access if not initialized
         
-        if (!m_IsLocked)
-            return true; // Vehicle is not locked, anyone can access
+        return m_LockRegistry.CanAccess(GetVehicleID(), TeamVehicleLockRegistry.GetPlayerHandle(player));
+    }
+    
+    /**
+     * @brief Reserve a seat for a team member
+     * In multiplayer the request goes to the server, which replicates the result.
+     * @param player The player making the reservation
+     * @param seatIndex The seat index (0 to TeamVehicleLockRegistry.MAX_SEATS - 1)
+     * @param holder The team member to reserve the seat for, null to free it
+     * @return True if the reservation was applied locally
+     */
+    bool ReserveSeat(IEntity player, int seatIndex, IEntity holder)
+    {
+        IEntity owner = GetOwner();
+        if (!owner || !m_LockRegistry)
+            return false;
+        
+        int holderHandle = TeamVehicleLockRegistry.GetPlayerHandle(holder);
+        TeamNetworkComponent networkComponent = TeamNetworkComponent.GetInstance();
+        if (GetGame().IsMultiplayer() && networkComponent)
+            return networkComponent.ReserveVehicleSeat(player.GetID(), owner.GetID(), seatIndex, holderHandle);
         
-        // Get player information
-        string playerID = GetPlayerIdentity(player);
+        return m_LockRegistry.TryReserveSeat(player, owner, seatIndex, holderHandle);
+    }
+    
+    /**
+     * @brief Get the player handle a seat is reserved for
+     * @param seatIndex The seat index
+     * @return The holder's player handle, or 0 if the seat is free
+     */
+    int GetSeatReservation(int seatIndex)
+    {
+        if (!m_LockRegistry)
+            return 0;
         
-        // The owner can always access
-        if (playerID == m_OwnerPlayerID)
+        return m_LockRegistry.GetSeatReservation(GetVehicleID(), seatIndex);
+    }
+    
+    /**
+     * @brief Check if a player may take a seat
+     * @param player The player trying to enter
+     * @param seatIndex The seat index, -1 for any seat
+     * @return True if the vehicle and the seat are open to the player
+     */
+    bool CanEnterSeat(IEntity player, int seatIndex)
+    {
+        if (!m_LockRegistry)
             return true;
         
-        // Check if player is in the same team as the owner
-        int playerTeamID = m_TeamManager.GetPlayerTeam(playerID);
-        if (playerTeamID > 0 && playerTeamID == m_OwnerTeamID)
+        return m_LockRegistry.CanUseSeat(GetVehicleID(), seatIndex, TeamVehicleLockRegistry.GetPlayerHandle(player));
+    }
+    
+    /**
+     * @brief Write the vehicle's lock record into the replication snapshot
+     * Layout: lock bit, then varint team and owner handle and the seat reservations when locked.
+     * @param writer The writer to serialize into
+     * @return True on success
+     */
+    override bool RplSave(ScriptBitWriter writer)
+    {
+        TeamVehicleLockRegistry lockRegistry = TeamVehicleLockRegistry.GetInstance();
+        int vehicleID = GetVehicleID();
+        
+        bool isLocked = lockRegistry.IsLocked(vehicleID);
+        writer.WriteBool(isLocked);
+        if (!isLocked)
             return true;
         
-        return false;
+        TeamChatMessage.WriteVarInt(writer, lockRegistry.GetOwnerTeamID(vehicleID));
+        TeamChatMessage.WriteVarInt(writer, lockRegistry.GetOwnerHandle(vehicleID));
+        lockRegistry.WriteSeatReservations(writer, vehicleID);
+        return true;
     }
     
     /**
-     * @brief Set the physical lock state of the vehicle
-     * @param isLocked Whether the vehicle should be locked
+     * @brief Apply the lock record from a replication snapshot
+     * May run before OnPostInit, so the registry is looked up directly.
+     * @param reader The reader to deserialize from
+     * @return True on success
      */
-    protected void SetVehicleLockState(bool isLocked)
+    override bool RplLoad(ScriptBitReader reader)
     {
-        IEntity owner = GetOwner();
-        if (!owner)
-            return;
-            
-        // Get vehicle component that handles locking
-        BaseVehicleComponent vehicleComponent = BaseVehicleComponent.Cast(owner.FindComponent(BaseVehicleComponent));
-        if (vehicleComponent)
+        TeamVehicleLockRegistry lockRegistry = TeamVehicleLockRegistry.GetInstance();
+        int vehicleID = GetVehicleID();
+        
+        if (!reader.ReadBool())
         {
-            vehicleComponent.SetLocked(isLocked);
-            Print("Vehicle " + owner.GetName() + " lock state set to: " + isLocked);
+            lockRegistry.ApplyUnlock(vehicleID);
+            return true;
         }
+        
+        int teamID = TeamChatMessage.ReadVarInt(reader);
+        int ownerHandle = TeamChatMessage.ReadVarInt(reader);
+        lockRegistry.ApplyLock(vehicleID, teamID, ownerHandle, GetGame().GetWorld().GetWorldTime());
+        lockRegistry.ReadSeatReservations(reader, vehicleID);
+        return true;
     }
     
     /**
-     * @brief Get the player's identity string
-     * @param player The player entity
-     * @return The player's identity string
+     * @brief Get the registry key of this vehicle
+     * @return The vehicle entity ID, or 0 without an owner
      */
-    protected string GetPlayerIdentity(IEntity player)
+    protected int GetVehicleID()
     {
-        if (!player)
-            return "";
-        
-        PlayerController pc = PlayerController.Cast(player.GetController());
-        if (!pc)
-            return "";
+        IEntity owner = GetOwner();
+        if (!owner)
+            return 0;
         
-        return pc.GetPlayerId().ToString();
+        return owner.GetID().GetValue();
     }
     
     /**
@@ -0,0 +1,164 @@
+/**
+ * @brief Server-side reclamation of abandoned vehicle locks
+ *
+ * Walks the records of TeamVehicleLockRegistry a fixed number per update. A locked vehicle
+ * with a member of its team within VehicleLockProximity counts as used; one that has not been
+ * used for VehicleLockIdleSeconds, whose team no longer exists or that no longer exists itself
+ * is unlocked. Player positions are gathered once per pass over the records, so a pass costs
+ * O(players + locks * team size) and never looks at unlocked vehicles or other entities.
+ *
+ * Locks released in one update are replicated together in one lock RPC.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+#include "TeamManagementSettings.c"
+#include "TeamVehicleLockRegistry.c"
+class TeamVehicleLockExpiry
+{
+    // Lock records checked per update
+    protected static const int RECORDS_CHECKED_PER_UPDATE = 32;
+
+    protected TeamManager m_TeamManager;
+    protected TeamVehicleLockRegistry m_LockRegistry;
+
+    // Next record to check; a pass starts when it is 0
+    protected int m_Cursor = 0;
+
+    // Player positions by player handle, gathered at the start of each pass
+    protected ref map<int, vector> m_PlayerPositions = new map<int, vector>();
+
+    // Vehicles unlocked during the current update
+    protected ref array<int> m_ExpiredVehicleIDs = new array<int>();
+
+    // Total number of locks released
+    protected int m_ReleasedCount = 0;
+
+    /**
+     * @brief Constructor
+     * @param teamManager The team manager whose teams own the locks
+     */
+    void TeamVehicleLockExpiry(TeamManager teamManager)
+    {
+        m_TeamManager = teamManager;
+        m_LockRegistry = TeamVehicleLockRegistry.GetInstance();
+    }
+
+    /**
+     * @brief Check the next slice of lock records
+     * Called from the world module every update on the server.
+     */
+    void Update()
+    {
+        TeamManagementSettings settings = TeamManagementSettings.Get();
+        if (settings.m_VehicleLockIdleSeconds <= 0 || m_LockRegistry.GetLockCount() == 0)
+        {
+            m_Cursor = 0;
+            return;
+        }
+
+        if (m_Cursor == 0)
+            GatherPlayerPositions();
+
+        float currentTime = GetGame().GetWorld().GetWorldTime();
+        int recordCount = m_LockRegistry.GetRecordCount();
+        for (int checked = 0; checked < RECORDS_CHECKED_PER_UPDATE && m_Cursor < recordCount; checked++)
+        {
+            int vehicleID = m_LockRegistry.GetRecordVehicleID(m_Cursor);
+            m_Cursor++;
+
+            if (vehicleID != 0)
+                CheckVehicle(vehicleID, currentTime, settings);
+        }
+
+        if (m_Cursor >= recordCount)
+            m_Cursor = 0;
+
+        if (m_ExpiredVehicleIDs.Count() == 0)
+            return;
+
+        m_ReleasedCount += m_ExpiredVehicleIDs.Count();
+        Print("TeamVehicleLockExpiry: Released " + m_ExpiredVehicleIDs.Count() + " abandoned vehicle locks");
+
+        TeamNetworkComponent networkComponent = TeamNetworkComponent.GetInstance();
+        if (GetGame().IsMultiplayer() && networkComponent)
+            networkComponent.BroadcastVehicleLockStates(m_ExpiredVehicleIDs);
+
+        m_ExpiredVehicleIDs.Clear();
+    }
+
+    /**
+     * @brief Get the total number of locks released
+     * @return The released lock count
+     */
+    int GetReleasedCount()
+    {
+        return m_ReleasedCount;
+    }
+
+    /**
+     * @brief Refresh or release one locked vehicle
+     * @param vehicleID The vehicle entity ID
+     * @param currentTime The current world time
+     * @param settings The active settings
+     */
+    protected void CheckVehicle(int vehicleID, float currentTime, TeamManagementSettings settings)
+    {
+        IEntity vehicle = GetGame().GetWorld().FindEntityByID(vehicleID);
+        int teamID = m_LockRegistry.GetOwnerTeamID(vehicleID);
+        if (vehicle && m_TeamManager.TeamExists(teamID))
+        {
+            if (IsTeamNearby(teamID, vehicle.GetOrigin(), settings.m_VehicleLockProximitySq))
+            {
+                m_LockRegistry.MarkUsed(vehicleID, currentTime);
+                return;
+            }
+
+            if (currentTime - m_LockRegistry.GetLastUseTime(vehicleID) < settings.m_VehicleLockIdleSeconds)
+                return;
+        }
+
+        m_LockRegistry.ApplyUnlock(vehicleID);
+        m_ExpiredVehicleIDs.Insert(vehicleID);
+    }
+
+    /**
+     * @brief Check if any member of a team is close to a position
+     * @param teamID The team ID
+     * @param position The position to check
+     * @param proximitySq The squared distance that counts as close
+     * @return True if a member is within the distance
+     */
+    protected bool IsTeamNearby(int teamID, vector position, float proximitySq)
+    {
+        int memberCount = m_TeamManager.GetTeamMemberCount(teamID);
+        for (int i = 0; i < memberCount; i++)
+        {
+            vector memberPosition;
+            if (!m_PlayerPositions.Find(m_TeamManager.GetTeamMemberHandle(teamID, i), memberPosition))
+                continue;
+
+            if (vector.DistanceSq(position, memberPosition) <= proximitySq)
+                return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Record the position of every player for the coming pass
+     */
+    protected void GatherPlayerPositions()
+    {
+        m_PlayerPositions.Clear();
+
+        array<EntityID> playerIDs = new array<EntityID>();
+        GetGame().GetWorld().GetPlayerManager().GetPlayerIDs(playerIDs);
+        foreach (EntityID id : playerIDs)
+        {
+            IEntity player = GetGame().GetWorld().FindEntityByID(id);
+            if (player)
+                m_PlayerPositions.Set(TeamVehicleLockRegistry.GetPlayerHandle(player), player.GetOrigin());
+        }
+    }
+}
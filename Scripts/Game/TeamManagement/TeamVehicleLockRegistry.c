@@ -0,0 +1,924 @@
+/**
+ * @brief Central registry of team vehicle locks
+ *
+ * The server owns one lock record per locked vehicle, keyed by the vehicle's entity ID:
+ * owning team, owning player handle, lock time and a version that increases with every
+ * change. Records live in parallel arrays with a free list, so locking and unlocking do not
+ * allocate once the arrays have grown, and vehicles nobody locked cost nothing. Access checks
+ * are one map lookup plus the O(1) player-to-team lookup of TeamManager.
+ *
+ * Records are also indexed by owning team and owning player. Each index entry remembers its
+ * position in the list, so removal is a swap with the last entry, and releasing or handing
+ * over everything a team or player holds costs O(locks held) rather than a scan.
+ *
+ * Interaction prompts may ask for the same vehicle and player every frame, so each record
+ * caches its last access decision together with the player handle, the record version and
+ * the membership epoch it was made at. A lock change only moves the version of its own
+ * record, and the epoch advances through InvalidateAccess on team membership changes, so a
+ * repeated check is answered by comparing three integers and locking one vehicle leaves the
+ * cached decisions of all others intact.
+ *
+ * Locked vehicles can also reserve seats for team members: a bitmask of reserved seats per
+ * record plus a fixed block of MAX_SEATS holder handles, so checking a seat on entry is a
+ * bit test and at most one team lookup. A reservation whose holder left the team is ignored.
+ *
+ * Clients keep a mirror that is updated from compact lock and unlock RPCs.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+#include "../Network/ScriptCallContext.c"
+#include "TeamChatMessage.c"
+class TeamVehicleLockRegistry
+{
+    // Seats per vehicle that can be reserved
+    static const int MAX_SEATS = 16;
+
+    // Singleton instance
+    private static ref TeamVehicleLockRegistry s_Instance;
+
+    // Record index by vehicle entity ID
+    protected ref map<int, int> m_RecordIndex = new map<int, int>();
+
+    // Per record: vehicle entity ID (0 if free), owning team, owning player handle, lock time, last use and version
+    protected ref array<int> m_VehicleIDs = new array<int>();
+    protected ref array<int> m_TeamIDs = new array<int>();
+    protected ref array<int> m_OwnerHandles = new array<int>();
+    protected ref array<float> m_LockTimes = new array<float>();
+    protected ref array<float> m_LastUseTimes = new array<float>();
+    protected ref array<int> m_Versions = new array<int>();
+
+    // Records per owning team and per owning player (player handle 0, held by the team, is not indexed)
+    protected ref map<int, ref array<int>> m_TeamLocks = new map<int, ref array<int>>();
+    protected ref map<int, ref array<int>> m_OwnerLocks = new map<int, ref array<int>>();
+
+    // Per record: position in its team list and its owner list
+    protected ref array<int> m_TeamListPositions = new array<int>();
+    protected ref array<int> m_OwnerListPositions = new array<int>();
+
+    // Per record: bitmask of reserved seats, and MAX_SEATS holder handles starting at record * MAX_SEATS
+    protected ref array<int> m_SeatMasks = new array<int>();
+    protected ref array<int> m_SeatHandles = new array<int>();
+
+    // Per record: player handle, record version, membership epoch and result of the last access decision
+    protected ref array<int> m_CachedHandles = new array<int>();
+    protected ref array<int> m_CachedVersions = new array<int>();
+    protected ref array<int> m_CachedEpochs = new array<int>();
+    protected ref array<bool> m_CachedResults = new array<bool>();
+
+    // Stack of released records, valid up to m_FreeRecordCount
+    protected ref array<int> m_FreeRecords = new array<int>();
+    protected int m_FreeRecordCount = 0;
+
+    // Vehicles found by the running sphere query
+    protected ref array<IEntity> m_QueriedVehicles;
+
+    // Increases with every lock change; stamps record versions
+    protected int m_ChangeCounter = 0;
+
+    // Increases with every team membership change; cached access decisions older than it are stale
+    protected int m_MembershipEpoch = 1;
+
+    /**
+     * @brief Get the singleton instance
+     * @return The registry
+     */
+    static TeamVehicleLockRegistry GetInstance()
+    {
+        if (!s_Instance)
+            s_Instance = new TeamVehicleLockRegistry();
+
+        return s_Instance;
+    }
+
+    /**
+     * @brief Lock a vehicle for the player's team
+     * Validates that the player is in a team and that the vehicle is not locked by another team.
+     * @param player The player locking the vehicle
+     * @param vehicle The vehicle to lock
+     * @return True if the vehicle is now locked for the player's team
+     */
+    bool TryLock(IEntity player, IEntity vehicle)
+    {
+        if (!player || !vehicle)
+            return false;
+
+        int playerHandle = GetPlayerHandle(player);
+        int teamID = TeamManager.GetInstance().GetPlayerTeamByHandle(playerHandle);
+        if (teamID <= 0)
+            return false;
+
+        int vehicleID = vehicle.GetID().GetValue();
+        if (!CanAccess(vehicleID, playerHandle))
+            return false;
+
+        ApplyLock(vehicleID, teamID, playerHandle, GetGame().GetWorld().GetWorldTime());
+        return true;
+    }
+
+    /**
+     * @brief Unlock a vehicle
+     * Only players with access to the vehicle may unlock it.
+     * @param player The player unlocking the vehicle
+     * @param vehicle The vehicle to unlock
+     * @return True if the vehicle was locked and is now unlocked
+     */
+    bool TryUnlock(IEntity player, IEntity vehicle)
+    {
+        if (!player || !vehicle)
+            return false;
+
+        int vehicleID = vehicle.GetID().GetValue();
+        if (!IsLocked(vehicleID) || !CanAccess(vehicleID, GetPlayerHandle(player)))
+            return false;
+
+        ApplyUnlock(vehicleID);
+        return true;
+    }
+
+    /**
+     * @brief Lock several vehicles for the player's team at once
+     * The player is resolved once; vehicles locked by another team, missing or listed twice are skipped.
+     * @param player The player locking the vehicles
+     * @param vehicles The vehicles to lock
+     * @param changedVehicleIDs Receives the IDs of the vehicles that were locked
+     * @return The number of vehicles locked
+     */
+    int TryLockAll(IEntity player, notnull array<IEntity> vehicles, notnull array<int> changedVehicleIDs)
+    {
+        int playerHandle = GetPlayerHandle(player);
+        int teamID = TeamManager.GetInstance().GetPlayerTeamByHandle(playerHandle);
+        if (teamID <= 0)
+            return 0;
+
+        float currentTime = GetGame().GetWorld().GetWorldTime();
+        set<int> seen = new set<int>();
+        int locked = 0;
+        foreach (IEntity vehicle : vehicles)
+        {
+            if (!vehicle)
+                continue;
+
+            int vehicleID = vehicle.GetID().GetValue();
+            if (!seen.Insert(vehicleID) || !CanAccess(vehicleID, playerHandle))
+                continue;
+
+            ApplyLock(vehicleID, teamID, playerHandle, currentTime);
+            changedVehicleIDs.Insert(vehicleID);
+            locked++;
+        }
+
+        return locked;
+    }
+
+    /**
+     * @brief Unlock several vehicles at once
+     * Vehicles that are not locked or locked by another team are skipped.
+     * @param player The player unlocking the vehicles
+     * @param vehicles The vehicles to unlock
+     * @param changedVehicleIDs Receives the IDs of the vehicles that were unlocked
+     * @return The number of vehicles unlocked
+     */
+    int TryUnlockAll(IEntity player, notnull array<IEntity> vehicles, notnull array<int> changedVehicleIDs)
+    {
+        int playerHandle = GetPlayerHandle(player);
+        int unlocked = 0;
+        foreach (IEntity vehicle : vehicles)
+        {
+            if (!vehicle)
+                continue;
+
+            // Unlocked vehicles, including ones listed twice, fail IsLocked
+            int vehicleID = vehicle.GetID().GetValue();
+            if (!IsLocked(vehicleID) || !CanAccess(vehicleID, playerHandle))
+                continue;
+
+            ApplyUnlock(vehicleID);
+            changedVehicleIDs.Insert(vehicleID);
+            unlocked++;
+        }
+
+        return unlocked;
+    }
+
+    /**
+     * @brief Find the vehicles within a radius
+     * @param center The center of the sphere
+     * @param radius The radius in meters
+     * @param vehicles Receives the vehicles found
+     * @param maxCount The maximum number of vehicles to return
+     */
+    void FindVehiclesInRadius(vector center, float radius, notnull array<IEntity> vehicles, int maxCount)
+    {
+        m_QueriedVehicles = vehicles;
+        GetGame().GetWorld().QueryEntitiesBySphere(center, radius, AddQueriedVehicle, null, EQueryEntitiesFlags.DYNAMIC);
+        m_QueriedVehicles = null;
+
+        if (vehicles.Count() > maxCount)
+            vehicles.Resize(maxCount);
+    }
+
+    /**
+     * @brief Record a lock without validation
+     * Used by the server after validating and by clients applying replicated state.
+     * @param vehicleID The vehicle entity ID
+     * @param teamID The owning team
+     * @param ownerHandle The player handle of the player who locked it
+     * @param lockTime World time of the lock
+     */
+    void ApplyLock(int vehicleID, int teamID, int ownerHandle, float lockTime)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record))
+        {
+            record = AcquireRecord();
+            m_VehicleIDs[record] = vehicleID;
+            m_RecordIndex.Set(vehicleID, record);
+            m_TeamIDs[record] = teamID;
+            m_OwnerHandles[record] = ownerHandle;
+            m_SeatMasks[record] = 0;
+            AddToIndex(m_TeamLocks, m_TeamListPositions, teamID, record);
+            AddToIndex(m_OwnerLocks, m_OwnerListPositions, ownerHandle, record);
+            SetPhysicalLock(vehicleID, true);
+        }
+        else
+        {
+            SetTeam(record, teamID);
+            SetOwner(record, ownerHandle);
+        }
+
+        m_LockTimes[record] = lockTime;
+        m_LastUseTimes[record] = lockTime;
+        m_ChangeCounter++;
+        m_Versions[record] = m_ChangeCounter;
+    }
+
+    /**
+     * @brief Remove a lock without validation
+     * @param vehicleID The vehicle entity ID
+     */
+    void ApplyUnlock(int vehicleID)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record))
+            return;
+
+        RemoveFromIndex(m_TeamLocks, m_TeamListPositions, m_TeamIDs[record], record);
+        RemoveFromIndex(m_OwnerLocks, m_OwnerListPositions, m_OwnerHandles[record], record);
+        m_RecordIndex.Remove(vehicleID);
+        m_VehicleIDs[record] = 0;
+        m_FreeRecords[m_FreeRecordCount] = record;
+        m_FreeRecordCount++;
+        m_ChangeCounter++;
+
+        SetPhysicalLock(vehicleID, false);
+    }
+
+    /**
+     * @brief Unlock every vehicle a team holds, e.g. when it disbands
+     * @param teamID The team ID
+     * @param changedVehicleIDs Receives the IDs of the unlocked vehicles
+     * @return The number of vehicles unlocked
+     */
+    int ReleaseTeamLocks(int teamID, notnull array<int> changedVehicleIDs)
+    {
+        int released = 0;
+        array<int> records;
+        while (m_TeamLocks.Find(teamID, records))
+        {
+            // Unlocking removes the record from the list, which is dropped once empty
+            int vehicleID = m_VehicleIDs[records[records.Count() - 1]];
+            ApplyUnlock(vehicleID);
+            changedVehicleIDs.Insert(vehicleID);
+            released++;
+        }
+
+        return released;
+    }
+
+    /**
+     * @brief Hand every lock a player owns to someone else, e.g. when they leave their team
+     * The locks keep their team, so the team keeps access while the player loses it.
+     * @param ownerHandle The current owner's player handle
+     * @param newOwnerHandle The new owner's player handle, 0 to leave the locks with the team alone
+     * @param changedVehicleIDs Receives the IDs of the changed vehicles
+     * @return The number of locks handed over
+     */
+    int TransferOwnerLocks(int ownerHandle, int newOwnerHandle, notnull array<int> changedVehicleIDs)
+    {
+        if (ownerHandle == 0 || ownerHandle == newOwnerHandle)
+            return 0;
+
+        int transferred = 0;
+        array<int> records;
+        while (m_OwnerLocks.Find(ownerHandle, records))
+        {
+            int record = records[records.Count() - 1];
+            SetOwner(record, newOwnerHandle);
+            m_ChangeCounter++;
+            m_Versions[record] = m_ChangeCounter;
+            changedVehicleIDs.Insert(m_VehicleIDs[record]);
+            transferred++;
+        }
+
+        return transferred;
+    }
+
+    /**
+     * @brief Get the number of vehicles a team holds
+     * @param teamID The team ID
+     * @return The lock count
+     */
+    int GetTeamLockCount(int teamID)
+    {
+        array<int> records;
+        if (!m_TeamLocks.Find(teamID, records))
+            return 0;
+
+        return records.Count();
+    }
+
+    /**
+     * @brief Get the number of locks a player owns
+     * @param ownerHandle The player handle
+     * @return The lock count
+     */
+    int GetOwnerLockCount(int ownerHandle)
+    {
+        array<int> records;
+        if (!m_OwnerLocks.Find(ownerHandle, records))
+            return 0;
+
+        return records.Count();
+    }
+
+    /**
+     * @brief Check if a player may use a vehicle
+     * @param vehicleID The vehicle entity ID
+     * @param playerHandle The player handle
+     * @return True if the vehicle is unlocked, or locked by the player or their team
+     */
+    bool CanAccess(int vehicleID, int playerHandle)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record))
+            return true;
+
+        return CanAccessRecord(record, playerHandle);
+    }
+
+    /**
+     * @brief Check if a player may take a seat of a vehicle
+     * @param vehicleID The vehicle entity ID
+     * @param seatIndex The seat index, -1 for any seat
+     * @param playerHandle The player handle
+     * @return True if the player may use the vehicle and the seat is free, theirs, or held by someone who left the team
+     */
+    bool CanUseSeat(int vehicleID, int seatIndex, int playerHandle)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record))
+            return true;
+
+        if (!CanAccessRecord(record, playerHandle))
+            return false;
+
+        if (seatIndex < 0 || seatIndex >= MAX_SEATS || (m_SeatMasks[record] & (1 << seatIndex)) == 0)
+            return true;
+
+        int holderHandle = m_SeatHandles[record * MAX_SEATS + seatIndex];
+        return holderHandle == playerHandle || TeamManager.GetInstance().GetPlayerTeamByHandle(holderHandle) != m_TeamIDs[record];
+    }
+
+    /**
+     * @brief Drop all cached access decisions
+     * Called by TeamManager whenever a player joins or leaves a team.
+     */
+    void InvalidateAccess()
+    {
+        m_MembershipEpoch++;
+    }
+
+    /**
+     * @brief Check if a vehicle is locked
+     * @param vehicleID The vehicle entity ID
+     * @return True if locked
+     */
+    bool IsLocked(int vehicleID)
+    {
+        return m_RecordIndex.Contains(vehicleID);
+    }
+
+    /**
+     * @brief Get the team that locked a vehicle
+     * @param vehicleID The vehicle entity ID
+     * @return The team ID, or 0 if not locked
+     */
+    int GetOwnerTeamID(int vehicleID)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record))
+            return 0;
+
+        return m_TeamIDs[record];
+    }
+
+    /**
+     * @brief Get the player who locked a vehicle
+     * @param vehicleID The vehicle entity ID
+     * @return The player handle, or 0 if not locked
+     */
+    int GetOwnerHandle(int vehicleID)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record))
+            return 0;
+
+        return m_OwnerHandles[record];
+    }
+
+    /**
+     * @brief Get the time a vehicle was locked
+     * @param vehicleID The vehicle entity ID
+     * @return The world time of the lock, or 0 if not locked
+     */
+    float GetLockTime(int vehicleID)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record))
+            return 0;
+
+        return m_LockTimes[record];
+    }
+
+    /**
+     * @brief Record that the owning team used or stayed near a locked vehicle
+     * @param vehicleID The vehicle entity ID
+     * @param time The current world time
+     */
+    void MarkUsed(int vehicleID, float time)
+    {
+        int record;
+        if (m_RecordIndex.Find(vehicleID, record))
+            m_LastUseTimes[record] = time;
+    }
+
+    /**
+     * @brief Get the time the owning team last used or stayed near a locked vehicle
+     * @param vehicleID The vehicle entity ID
+     * @return The world time, or 0 if not locked
+     */
+    float GetLastUseTime(int vehicleID)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record))
+            return 0;
+
+        return m_LastUseTimes[record];
+    }
+
+    /**
+     * @brief Reserve or free a seat of a locked vehicle
+     * Both the requesting player and the reserved player must be in the team holding the lock.
+     * @param player The player making the reservation
+     * @param vehicle The vehicle
+     * @param seatIndex The seat index
+     * @param holderHandle The player handle the seat is reserved for, 0 to free it
+     * @return True if the reservation was applied
+     */
+    bool TryReserveSeat(IEntity player, IEntity vehicle, int seatIndex, int holderHandle)
+    {
+        if (!player || !vehicle || seatIndex < 0 || seatIndex >= MAX_SEATS)
+            return false;
+
+        int vehicleID = vehicle.GetID().GetValue();
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record))
+            return false;
+
+        TeamManager teamManager = TeamManager.GetInstance();
+        int teamID = m_TeamIDs[record];
+        if (teamManager.GetPlayerTeamByHandle(GetPlayerHandle(player)) != teamID)
+            return false;
+
+        if (holderHandle != 0 && teamManager.GetPlayerTeamByHandle(holderHandle) != teamID)
+            return false;
+
+        ApplySeatReservation(vehicleID, seatIndex, holderHandle);
+        return true;
+    }
+
+    /**
+     * @brief Reserve or free a seat without validation
+     * @param vehicleID The vehicle entity ID
+     * @param seatIndex The seat index
+     * @param holderHandle The player handle the seat is reserved for, 0 to free it
+     */
+    void ApplySeatReservation(int vehicleID, int seatIndex, int holderHandle)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record) || seatIndex < 0 || seatIndex >= MAX_SEATS)
+            return;
+
+        m_SeatHandles[record * MAX_SEATS + seatIndex] = holderHandle;
+        if (holderHandle != 0)
+            m_SeatMasks[record] = m_SeatMasks[record] | (1 << seatIndex);
+        else
+            m_SeatMasks[record] = m_SeatMasks[record] & ~(1 << seatIndex);
+
+        m_ChangeCounter++;
+        m_Versions[record] = m_ChangeCounter;
+    }
+
+    /**
+     * @brief Get the player a seat is reserved for
+     * @param vehicleID The vehicle entity ID
+     * @param seatIndex The seat index
+     * @return The holder's player handle, or 0 if the seat is not reserved
+     */
+    int GetSeatReservation(int vehicleID, int seatIndex)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record) || seatIndex < 0 || seatIndex >= MAX_SEATS)
+            return 0;
+
+        if ((m_SeatMasks[record] & (1 << seatIndex)) == 0)
+            return 0;
+
+        return m_SeatHandles[record * MAX_SEATS + seatIndex];
+    }
+
+    /**
+     * @brief Get the version of a vehicle's lock record
+     * @param vehicleID The vehicle entity ID
+     * @return The version, or 0 if not locked
+     */
+    int GetVersion(int vehicleID)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record))
+            return 0;
+
+        return m_Versions[record];
+    }
+
+    /**
+     * @brief Get the number of locked vehicles
+     * @return The lock count
+     */
+    int GetLockCount()
+    {
+        return m_RecordIndex.Count();
+    }
+
+    /**
+     * @brief Get the number of records, locked or free
+     * Records can be walked by index to visit every lock without touching other vehicles.
+     * @return The record count
+     */
+    int GetRecordCount()
+    {
+        return m_VehicleIDs.Count();
+    }
+
+    /**
+     * @brief Get the number of values the registry holds, as a measure of its memory use
+     * Counts every record field, seat holder, free list entry, index entry and map key and value.
+     * @return The stored value count
+     */
+    int GetStoredValueCount()
+    {
+        int count = m_RecordIndex.Count() * 2 + m_FreeRecords.Count() + m_SeatHandles.Count();
+        count += m_VehicleIDs.Count() * 13;
+
+        foreach (int teamID, array<int> teamRecords : m_TeamLocks)
+        {
+            count += 1 + teamRecords.Count();
+        }
+
+        foreach (int ownerHandle, array<int> ownerRecords : m_OwnerLocks)
+        {
+            count += 1 + ownerRecords.Count();
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Get the vehicle of a record
+     * @param record The record index
+     * @return The vehicle entity ID, or 0 if the record is free
+     */
+    int GetRecordVehicleID(int record)
+    {
+        return m_VehicleIDs[record];
+    }
+
+    /**
+     * @brief Write the lock states of several vehicles
+     * Layout: varint count, then per vehicle a 32-bit vehicle ID, a lock bit and, when locked,
+     * varint team and owner handle.
+     * @param writer The writer to serialize into
+     * @param vehicleIDs The vehicle entity IDs
+     */
+    void WriteLockStates(ScriptBitWriter writer, notnull array<int> vehicleIDs)
+    {
+        TeamChatMessage.WriteVarInt(writer, vehicleIDs.Count());
+        foreach (int vehicleID : vehicleIDs)
+        {
+            writer.WriteInt(vehicleID);
+
+            int record;
+            bool isLocked = m_RecordIndex.Find(vehicleID, record);
+            writer.WriteBool(isLocked);
+            if (!isLocked)
+                continue;
+
+            TeamChatMessage.WriteVarInt(writer, m_TeamIDs[record]);
+            TeamChatMessage.WriteVarInt(writer, m_OwnerHandles[record]);
+        }
+    }
+
+    /**
+     * @brief Apply lock states written by WriteLockStates
+     * @param reader The reader to deserialize from
+     */
+    void ReadLockStates(ScriptBitReader reader)
+    {
+        float currentTime = GetGame().GetWorld().GetWorldTime();
+        int count = TeamChatMessage.ReadVarInt(reader);
+        for (int i = 0; i < count; i++)
+        {
+            int vehicleID = reader.ReadInt();
+            if (!reader.ReadBool())
+            {
+                ApplyUnlock(vehicleID);
+                continue;
+            }
+
+            int teamID = TeamChatMessage.ReadVarInt(reader);
+            int ownerHandle = TeamChatMessage.ReadVarInt(reader);
+            if (IsLocked(vehicleID) && GetOwnerTeamID(vehicleID) == teamID)
+            {
+                // Ownership change only; keep the lock time
+                ApplyLock(vehicleID, teamID, ownerHandle, GetLockTime(vehicleID));
+                continue;
+            }
+
+            ApplyLock(vehicleID, teamID, ownerHandle, currentTime);
+        }
+    }
+
+    /**
+     * @brief Write one seat change
+     * Layout: 32-bit vehicle ID, 4-bit seat index, varint holder handle (0 frees the seat).
+     * @param writer The writer to serialize into
+     * @param vehicleID The vehicle entity ID
+     * @param seatIndex The seat index
+     */
+    void WriteSeatDelta(ScriptBitWriter writer, int vehicleID, int seatIndex)
+    {
+        writer.WriteInt(vehicleID);
+        writer.WriteIntRange(seatIndex, 0, MAX_SEATS - 1);
+        TeamChatMessage.WriteVarInt(writer, GetSeatReservation(vehicleID, seatIndex));
+    }
+
+    /**
+     * @brief Apply a seat change written by WriteSeatDelta
+     * @param reader The reader to deserialize from
+     */
+    void ReadSeatDelta(ScriptBitReader reader)
+    {
+        int vehicleID = reader.ReadInt();
+        int seatIndex = reader.ReadIntRange(0, MAX_SEATS - 1);
+        ApplySeatReservation(vehicleID, seatIndex, TeamChatMessage.ReadVarInt(reader));
+    }
+
+    /**
+     * @brief Write all seat reservations of a locked vehicle
+     * Layout: MAX_SEATS-bit mask, then a varint holder handle per reserved seat.
+     * @param writer The writer to serialize into
+     * @param vehicleID The vehicle entity ID
+     */
+    void WriteSeatReservations(ScriptBitWriter writer, int vehicleID)
+    {
+        int record;
+        if (!m_RecordIndex.Find(vehicleID, record))
+        {
+            writer.WriteIntRange(0, 0, (1 << MAX_SEATS) - 1);
+            return;
+        }
+
+        int mask = m_SeatMasks[record];
+        writer.WriteIntRange(mask, 0, (1 << MAX_SEATS) - 1);
+        for (int seat = 0; seat < MAX_SEATS; seat++)
+        {
+            if ((mask & (1 << seat)) != 0)
+                TeamChatMessage.WriteVarInt(writer, m_SeatHandles[record * MAX_SEATS + seat]);
+        }
+    }
+
+    /**
+     * @brief Apply seat reservations written by WriteSeatReservations
+     * @param reader The reader to deserialize from
+     * @param vehicleID The vehicle entity ID, which must be locked
+     */
+    void ReadSeatReservations(ScriptBitReader reader, int vehicleID)
+    {
+        int mask = reader.ReadIntRange(0, (1 << MAX_SEATS) - 1);
+        for (int seat = 0; seat < MAX_SEATS; seat++)
+        {
+            int holderHandle = 0;
+            if ((mask & (1 << seat)) != 0)
+                holderHandle = TeamChatMessage.ReadVarInt(reader);
+
+            ApplySeatReservation(vehicleID, seat, holderHandle);
+        }
+    }
+
+    /**
+     * @brief Get the numeric handle of a player
+     * @param player The player entity
+     * @return The player handle, or 0 if the entity has no player controller
+     */
+    static int GetPlayerHandle(IEntity player)
+    {
+        if (!player)
+            return 0;
+
+        PlayerController pc = PlayerController.Cast(player.GetController());
+        if (!pc)
+            return 0;
+
+        return pc.GetPlayerId();
+    }
+
+    /**
+     * @brief Sphere query callback collecting vehicles
+     * @param entity The entity found
+     * @return True to continue the query
+     */
+    protected bool AddQueriedVehicle(IEntity entity)
+    {
+        if (entity.FindComponent(BaseVehicleComponent))
+            m_QueriedVehicles.Insert(entity);
+
+        return true;
+    }
+
+    /**
+     * @brief Check if a player may use the vehicle of a record, using the cached decision if current
+     * @param record The record index
+     * @param playerHandle The player handle
+     * @return True if the player owns the lock or is in the owning team
+     */
+    protected bool CanAccessRecord(int record, int playerHandle)
+    {
+        if (m_CachedHandles[record] == playerHandle && m_CachedVersions[record] == m_Versions[record] && m_CachedEpochs[record] == m_MembershipEpoch)
+            return m_CachedResults[record];
+
+        bool canAccess = m_OwnerHandles[record] == playerHandle;
+        if (!canAccess)
+        {
+            int teamID = TeamManager.GetInstance().GetPlayerTeamByHandle(playerHandle);
+            canAccess = teamID > 0 && teamID == m_TeamIDs[record];
+        }
+
+        m_CachedHandles[record] = playerHandle;
+        m_CachedVersions[record] = m_Versions[record];
+        m_CachedEpochs[record] = m_MembershipEpoch;
+        m_CachedResults[record] = canAccess;
+        return canAccess;
+    }
+
+    /**
+     * @brief Take a free record, growing the arrays if none is left
+     * @return The record index
+     */
+    protected int AcquireRecord()
+    {
+        if (m_FreeRecordCount > 0)
+        {
+            m_FreeRecordCount--;
+            return m_FreeRecords[m_FreeRecordCount];
+        }
+
+        int record = m_VehicleIDs.Insert(0);
+        m_TeamIDs.Insert(0);
+        m_OwnerHandles.Insert(0);
+        m_LockTimes.Insert(0);
+        m_LastUseTimes.Insert(0);
+        m_Versions.Insert(0);
+        m_TeamListPositions.Insert(-1);
+        m_OwnerListPositions.Insert(-1);
+        m_CachedHandles.Insert(0);
+        m_CachedVersions.Insert(0);
+        m_CachedEpochs.Insert(0);
+        m_CachedResults.Insert(false);
+        m_SeatMasks.Insert(0);
+        for (int seat = 0; seat < MAX_SEATS; seat++)
+        {
+            m_SeatHandles.Insert(0);
+        }
+        m_FreeRecords.Insert(0); // Keeps room to release every record
+        return record;
+    }
+
+    /**
+     * @brief Move a record to another owning team
+     * @param record The record index
+     * @param teamID The new team ID
+     */
+    protected void SetTeam(int record, int teamID)
+    {
+        if (m_TeamIDs[record] == teamID)
+            return;
+
+        RemoveFromIndex(m_TeamLocks, m_TeamListPositions, m_TeamIDs[record], record);
+        m_TeamIDs[record] = teamID;
+        AddToIndex(m_TeamLocks, m_TeamListPositions, teamID, record);
+    }
+
+    /**
+     * @brief Move a record to another owning player
+     * @param record The record index
+     * @param ownerHandle The new owner's player handle
+     */
+    protected void SetOwner(int record, int ownerHandle)
+    {
+        if (m_OwnerHandles[record] == ownerHandle)
+            return;
+
+        RemoveFromIndex(m_OwnerLocks, m_OwnerListPositions, m_OwnerHandles[record], record);
+        m_OwnerHandles[record] = ownerHandle;
+        AddToIndex(m_OwnerLocks, m_OwnerListPositions, ownerHandle, record);
+    }
+
+    /**
+     * @brief Append a record to a key's list in an index
+     * @param index The team or owner index
+     * @param positions The matching per-record list positions
+     * @param key The team ID or player handle; 0 is not indexed
+     * @param record The record index
+     */
+    protected void AddToIndex(map<int, ref array<int>> index, array<int> positions, int key, int record)
+    {
+        if (key == 0)
+            return;
+
+        array<int> records;
+        if (!index.Find(key, records))
+        {
+            records = new array<int>();
+            index.Set(key, records);
+        }
+
+        positions[record] = records.Insert(record);
+    }
+
+    /**
+     * @brief Remove a record from a key's list in an index by swapping in the last entry
+     * @param index The team or owner index
+     * @param positions The matching per-record list positions
+     * @param key The team ID or player handle; 0 is not indexed
+     * @param record The record index
+     */
+    protected void RemoveFromIndex(map<int, ref array<int>> index, array<int> positions, int key, int record)
+    {
+        array<int> records;
+        if (key == 0 || !index.Find(key, records))
+            return;
+
+        int position = positions[record];
+        int last = records.Count() - 1;
+        if (position != last)
+        {
+            int movedRecord = records[last];
+            records[position] = movedRecord;
+            positions[movedRecord] = position;
+        }
+
+        records.Remove(last);
+        positions[record] = -1;
+
+        // Empty lists are dropped: the keys are team IDs and player handles, which are reused, and the index must only hold current lock holders
+        if (records.Count() == 0)
+            index.Remove(key);
+    }
+
+    /**
+     * @brief Set the engine-side lock of a vehicle's doors
+     * @param vehicleID The vehicle entity ID
+     * @param isLocked Whether the vehicle should be locked
+     */
+    protected void SetPhysicalLock(int vehicleID, bool isLocked)
+    {
+        IEntity vehicle = GetGame().GetWorld().FindEntityByID(vehicleID);
+        if (!vehicle)
+            return;
+
+        BaseVehicleComponent vehicleComponent = BaseVehicleComponent.Cast(vehicle.FindComponent(BaseVehicleComponent));
+        if (vehicleComponent)
+            vehicleComponent.SetLocked(isLocked);
+    }
+}
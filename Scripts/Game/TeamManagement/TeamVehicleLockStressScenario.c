@@ -0,0 +1,303 @@
+/**
+ * @brief Stress scenario for team vehicle locking on the server
+ *
+ * Spawns vehicle entities carrying TeamVehicleComponent and player entities in full teams
+ * into the current world, then drives random lock, unlock, access check and seat entry
+ * attempts through the same entry points the game uses. Operations run in rounds of one kind,
+ * since the tick counter only resolves milliseconds; the kind of each round and its players
+ * and vehicles are drawn from a seeded generator, so a run can be repeated.
+ *
+ * Reports server time per operation, the lock RPCs and bytes sent, and how much the lock
+ * registry grew. Everything spawned is removed again and the stress teams are disbanded.
+ * Meant for an otherwise empty server, e.g. a headless test world.
+ */
+
+// Import necessary classes from the engine
+#include "../Core/Collections.c"
+#include "../Core/PlayerController.c"
+#include "TeamManager.c"
+#include "TeamNetworkComponent.c"
+#include "TeamVehicleComponent.c"
+#include "TeamVehicleLockRegistry.c"
+
+enum ETeamVehicleLockStressOperation
+{
+    LOCK,
+    UNLOCK,
+    ACCESS,
+    ENTER
+}
+
+class TeamVehicleLockStressScenario
+{
+    // Operations per timed round
+    protected static const int OPERATIONS_PER_ROUND = 250;
+
+    // Player handles of stress players start here, clear of real players
+    protected static const int FIRST_PLAYER_HANDLE = 100000;
+
+    // Seats drawn for entry attempts; -1 is the whole vehicle
+    protected static const int ENTER_SEAT_COUNT = 4;
+
+    // Operation names in ETeamVehicleLockStressOperation order
+    protected ref array<string> m_OperationNames = { "Lock", "Unlock", "Access", "Enter" };
+
+    // Per operation kind: attempts, successes and milliseconds spent
+    protected ref array<int> m_OperationCounts = new array<int>();
+    protected ref array<int> m_SuccessCounts = new array<int>();
+    protected ref array<int> m_OperationTicks = new array<int>();
+
+    // Spawned entities; controllers and components are kept alive by the scenario
+    protected ref array<ref IEntity> m_Vehicles = new array<ref IEntity>();
+    protected ref array<ref IEntity> m_Players = new array<ref IEntity>();
+    protected ref array<ref PlayerController> m_Controllers = new array<ref PlayerController>();
+    protected ref array<ref TeamVehicleComponent> m_VehicleComponents = new array<ref TeamVehicleComponent>();
+
+    protected ref RandomGenerator m_Random = new RandomGenerator();
+
+    protected TeamVehicleLockRegistry m_LockRegistry;
+
+    /**
+     * @brief Run the scenario and print its report
+     * @param vehicleCount Number of vehicles to spawn
+     * @param playerCount Number of players to spawn; they are split into teams of MaxTeamSize
+     * @param operationCount Number of random operations
+     * @param seed Seed for the random generator
+     * @return True if the scenario ran
+     */
+    static bool Run(int vehicleCount = 500, int playerCount = 128, int operationCount = 100000, int seed = 1)
+    {
+        if (!GetGame().IsServer())
+        {
+            Print("TeamVehicleLockStressScenario: Only the server can run the scenario");
+            return false;
+        }
+
+        TeamVehicleLockStressScenario scenario = new TeamVehicleLockStressScenario();
+        return scenario.Execute(vehicleCount, playerCount, operationCount, seed);
+    }
+
+    /**
+     * @brief Constructor
+     */
+    void TeamVehicleLockStressScenario()
+    {
+        m_LockRegistry = TeamVehicleLockRegistry.GetInstance();
+
+        for (int operation = 0; operation < m_OperationNames.Count(); operation++)
+        {
+            m_OperationCounts.Insert(0);
+            m_SuccessCounts.Insert(0);
+            m_OperationTicks.Insert(0);
+        }
+    }
+
+    /**
+     * @brief Spawn, drive, report and clean up
+     * @param vehicleCount Number of vehicles to spawn
+     * @param playerCount Number of players to spawn
+     * @param operationCount Number of random operations
+     * @param seed Seed for the random generator
+     * @return True if the scenario ran
+     */
+    protected bool Execute(int vehicleCount, int playerCount, int operationCount, int seed)
+    {
+        if (vehicleCount <= 0 || playerCount <= 0)
+            return false;
+
+        m_Random.SetSeed(seed);
+
+        int recordsBefore = m_LockRegistry.GetRecordCount();
+        int valuesBefore = m_LockRegistry.GetStoredValueCount();
+
+        SpawnVehicles(vehicleCount);
+        SpawnPlayers(playerCount);
+        if (!CreateTeams())
+        {
+            Print("TeamVehicleLockStressScenario: Could not create the stress teams; the scenario needs an empty server");
+            Cleanup();
+            return false;
+        }
+
+        RplComponent.ResetSentStats();
+
+        for (int done = 0; done < operationCount; done += OPERATIONS_PER_ROUND)
+        {
+            int operation = m_Random.RandInt(0, m_OperationNames.Count());
+            RunRound(operation, Math.Min(OPERATIONS_PER_ROUND, operationCount - done));
+        }
+
+        Report(recordsBefore, valuesBefore);
+        Cleanup();
+        return true;
+    }
+
+    /**
+     * @brief Run one timed round of a single operation kind on random players and vehicles
+     * @param operation The ETeamVehicleLockStressOperation to run
+     * @param count Number of operations in the round
+     */
+    protected void RunRound(int operation, int count)
+    {
+        TeamNetworkComponent networkComponent = TeamNetworkComponent.GetInstance();
+        int successes = 0;
+
+        int startTick = System.GetTickCount();
+        for (int i = 0; i < count; i++)
+        {
+            IEntity player = m_Players[m_Random.RandInt(0, m_Players.Count())];
+            int vehicleIndex = m_Random.RandInt(0, m_Vehicles.Count());
+            IEntity vehicle = m_Vehicles[vehicleIndex];
+
+            bool succeeded = false;
+            switch (operation)
+            {
+                case ETeamVehicleLockStressOperation.LOCK:
+                    if (networkComponent)
+                        succeeded = networkComponent.LockVehicle(player.GetID(), vehicle.GetID());
+                    else
+                        succeeded = m_LockRegistry.TryLock(player, vehicle);
+                    break;
+
+                case ETeamVehicleLockStressOperation.UNLOCK:
+                    if (networkComponent)
+                        succeeded = networkComponent.UnlockVehicle(player.GetID(), vehicle.GetID());
+                    else
+                        succeeded = m_LockRegistry.TryUnlock(player, vehicle);
+                    break;
+
+                case ETeamVehicleLockStressOperation.ACCESS:
+                    succeeded = m_VehicleComponents[vehicleIndex].CanAccessVehicle(player);
+                    break;
+
+                case ETeamVehicleLockStressOperation.ENTER:
+                    succeeded = m_VehicleComponents[vehicleIndex].CanEnterSeat(player, m_Random.RandInt(-1, ENTER_SEAT_COUNT));
+                    break;
+            }
+
+            if (succeeded)
+                successes++;
+        }
+
+        m_OperationTicks[operation] = m_OperationTicks[operation] + System.GetTickCount() - startTick;
+        m_OperationCounts[operation] = m_OperationCounts[operation] + count;
+        m_SuccessCounts[operation] = m_SuccessCounts[operation] + successes;
+    }
+
+    /**
+     * @brief Spawn vehicle entities with a TeamVehicleComponent each
+     * @param count Number of vehicles
+     */
+    protected void SpawnVehicles(int count)
+    {
+        World world = GetGame().GetWorld();
+        for (int i = 0; i < count; i++)
+        {
+            IEntity vehicle = new IEntity("TeamVehicleLockStress_Vehicle" + i);
+            world.AddEntity(vehicle);
+
+            TeamVehicleComponent component = new TeamVehicleComponent();
+            vehicle.AddComponent(component);
+            component.OnPostInit(vehicle);
+
+            m_Vehicles.Insert(vehicle);
+            m_VehicleComponents.Insert(component);
+        }
+    }
+
+    /**
+     * @brief Spawn player entities, each controlled by its own player controller
+     * @param count Number of players
+     */
+    protected void SpawnPlayers(int count)
+    {
+        World world = GetGame().GetWorld();
+        for (int i = 0; i < count; i++)
+        {
+            string name = "TeamVehicleLockStress_Player" + i;
+            IEntity player = new IEntity(name);
+            world.AddEntity(player);
+
+            PlayerController controller = new PlayerController(FIRST_PLAYER_HANDLE + i, name);
+            controller.SetPlayerEntity(player);
+
+            m_Players.Insert(player);
+            m_Controllers.Insert(controller);
+        }
+    }
+
+    /**
+     * @brief Put the stress players into full teams with one bulk operation
+     * @return True if the teams were created
+     */
+    protected bool CreateTeams()
+    {
+        int teamSize = TeamManagementSettings.Get().m_MaxTeamSize;
+        array<ref array<EntityID>> groups = new array<ref array<EntityID>>();
+        for (int i = 0; i < m_Players.Count(); i++)
+        {
+            if (i % teamSize == 0)
+                groups.Insert(new array<EntityID>());
+
+            groups[groups.Count() - 1].Insert(m_Players[i].GetID());
+        }
+
+        array<int> teamIDs;
+        return TeamManager.GetInstance().CreateTeams(groups, teamIDs);
+    }
+
+    /**
+     * @brief Print the measurements
+     * @param recordsBefore Registry record count before the scenario
+     * @param valuesBefore Registry stored value count before the scenario
+     */
+    protected void Report(int recordsBefore, int valuesBefore)
+    {
+        Print("TeamVehicleLockStressScenario: " + m_Vehicles.Count() + " vehicles, " + m_Players.Count() + " players");
+
+        for (int operation = 0; operation < m_OperationNames.Count(); operation++)
+        {
+            int count = m_OperationCounts[operation];
+            if (count == 0)
+                continue;
+
+            float microsecondsPerOperation = m_OperationTicks[operation] * 1000.0 / count;
+            Print(string.Format("TeamVehicleLockStressScenario: %1: %2 ops, %3 succeeded, %4 ms, %5 us/op", m_OperationNames[operation], count, m_SuccessCounts[operation], m_OperationTicks[operation], microsecondsPerOperation));
+        }
+
+        int changes = m_SuccessCounts[ETeamVehicleLockStressOperation.LOCK] + m_SuccessCounts[ETeamVehicleLockStressOperation.UNLOCK];
+        int rpcCount = RplComponent.GetSentRpcCount();
+        int sentBytes = RplComponent.GetSentBytes();
+        Print(string.Format("TeamVehicleLockStressScenario: Sent %1 RPCs, %2 bytes, %3 bytes per lock change", rpcCount, sentBytes, sentBytes / Math.Max(changes, 1)));
+
+        Print(string.Format("TeamVehicleLockStressScenario: %1 vehicles locked; registry grew by %2 records and %3 stored values (%4 components attached)", m_LockRegistry.GetLockCount(), m_LockRegistry.GetRecordCount() - recordsBefore, m_LockRegistry.GetStoredValueCount() - valuesBefore, m_VehicleComponents.Count()));
+    }
+
+    /**
+     * @brief Disband the stress teams, which releases their locks, and remove the spawned entities
+     */
+    protected void Cleanup()
+    {
+        TeamManager teamManager = TeamManager.GetInstance();
+        map<int, int> assignments = new map<int, int>();
+        foreach (IEntity player : m_Players)
+        {
+            if (teamManager.GetPlayerTeamByHandle(TeamVehicleLockRegistry.GetPlayerHandle(player)) > 0)
+                assignments.Set(player.GetID().GetValue(), 0);
+        }
+
+        if (assignments.Count() > 0)
+            teamManager.AssignPlayers(assignments);
+
+        World world = GetGame().GetWorld();
+        foreach (IEntity vehicle : m_Vehicles)
+        {
+            world.RemoveEntity(vehicle);
+        }
+
+        foreach (IEntity playerEntity : m_Players)
+        {
+            world.RemoveEntity(playerEntity);
+        }
+    }
+}
@@ -331,7 +331,7 @@ class TeamVisualsComponent : ScriptComponent
             m_MapMarker.SetIconFromResource(MAP_MEMBER_ICON_RESOURCE);
 
         // Set team color
-        int colorIndex = (m_CurrentTeamID - 1) % TEAM_COLORS.Count();
+        int colorIndex = TeamRoster.GetSlotFromTeamID(m_CurrentTeamID) % TEAM_COLORS.Count();
         m_MapMarker.SetBaseColor(TEAM_COLORS[colorIndex]);
 
         // Set display name (player name)
@@ -364,7 +364,7 @@ class TeamVisualsComponent : ScriptComponent
             m_HudIcon.SetIconResource(MEMBER_ICON_RESOURCE);
 
         // Set team color
-        int colorIndex = (m_CurrentTeamID - 1) % TEAM_COLORS.Count();
+        int colorIndex = TeamRoster.GetSlotFromTeamID(m_CurrentTeamID) % TEAM_COLORS.Count();
         m_HudIcon.SetColor(TEAM_COLORS[colorIndex]);
 
         // Set display name (player name)
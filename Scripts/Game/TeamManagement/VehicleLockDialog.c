@@ -15,7 +15,8 @@ class VehicleLockDialog: ScriptedWidgetComponent
     protected IEntity m_Vehicle;
     protected IEntity m_Player;
     protected TeamPlayerComponent m_PlayerComponent;
-    protected TeamVehicleComponent m_VehicleComponent;
+    protected TeamVehicleLockRegistry m_LockRegistry;
+    protected int m_VehicleID;
     protected bool m_IsInTeam;
     protected int m_TeamID;
     
@@ -30,13 +31,10 @@ class VehicleLockDialog: ScriptedWidgetComponent
         
         // Get components
         m_PlayerComponent = TeamPlayerComponent.Cast(m_Player.FindComponent(TeamPlayerComponent));
-        m_VehicleComponent = TeamVehicleComponent.Cast(m_Vehicle.FindComponent(TeamVehicleComponent));
         
-        // Create vehicle component if it doesn't exist
-        if (!m_VehicleComponent && m_PlayerComponent)
-        {
-            m_VehicleComponent = m_PlayerComponent.GetOrCreateVehicleComponent(m_Vehicle);
-        }
+        // Lock state is read from the registry, which clients mirror from the server
+        m_LockRegistry = TeamVehicleLockRegistry.GetInstance();
+        m_VehicleID = m_Vehicle.GetID().GetValue();
         
         // Get team info
         m_IsInTeam = false;
@@ -80,16 +78,12 @@ class VehicleLockDialog: ScriptedWidgetComponent
             m_VehicleNameText.SetText("Vehicle: " + m_Vehicle.GetName());
         
         // Update lock status
-        bool isLocked = false;
+        bool isLocked = m_LockRegistry.IsLocked(m_VehicleID);
         string lockOwner = "None";
         
-        if (m_VehicleComponent)
-        {
-            isLocked = m_VehicleComponent.IsLocked();
-            int ownerTeamID = m_VehicleComponent.GetOwnerTeamID();
-            if (ownerTeamID > 0)
-                lockOwner = "Team " + ownerTeamID;
-        }
+        int ownerTeamID = m_LockRegistry.GetOwnerTeamID(m_VehicleID);
+        if (ownerTeamID > 0)
+            lockOwner = "Team " + TeamManager.GetTeamDisplayNumber(ownerTeamID);
         
         if (m_LockStatusText)
         {
@@ -103,7 +97,7 @@ class VehicleLockDialog: ScriptedWidgetComponent
         if (m_TeamInfoText)
         {
             if (m_IsInTeam)
-                m_TeamInfoText.SetText("Your Team: Team " + m_TeamID);
+                m_TeamInfoText.SetText("Your Team: Team " + TeamManager.GetTeamDisplayNumber(m_TeamID));
             else
                 m_TeamInfoText.SetText("You are not in a team");
         }
@@ -145,7 +139,7 @@ class VehicleLockDialog: ScriptedWidgetComponent
         if (m_UnlockButton)
         {
             // Only enable unlock if vehicle is locked and player is owner or in same team
-            bool canUnlock = isLocked && m_VehicleComponent && m_VehicleComponent.CanAccessVehicle(m_Player);
+            bool canUnlock = isLocked && m_LockRegistry.CanAccess(m_VehicleID, TeamVehicleLockRegistry.GetPlayerHandle(m_Player));
             m_UnlockButton.SetEnabled(canUnlock);
         }
     }
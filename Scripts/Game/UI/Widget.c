@@ -22,6 +22,9 @@ class Widget
     // Visibility
     protected bool m_IsVisible = true;
     
+    // Opacity (0 = transparent, 1 = opaque)
+    protected float m_Opacity = 1.0;
+    
     // Internal widget reference for the actual UI system
     protected int m_InternalWidgetID;
     
@@ -177,6 +180,24 @@ class Widget
         m_IsVisible = visible;
     }
     
+    /**
+     * @brief Get the opacity of the widget
+     * @return The opacity (0 = transparent, 1 = opaque)
+     */
+    float GetOpacity()
+    {
+        return m_Opacity;
+    }
+    
+    /**
+     * @brief Set the opacity of the widget
+     * @param opacity The new opacity (0 = transparent, 1 = opaque)
+     */
+    void SetOpacity(float opacity)
+    {
+        m_Opacity = opacity;
+    }
+    
     /**
      * @brief Find a child widget by name
      * @param name The name of the widget to find
@@ -15,17 +15,23 @@ class TeamManagementModule : ScriptModule
     // Team network component reference
     protected ref TeamNetworkComponent m_NetworkComponent;
     
+    // Automatic team formation engine (server only)
+    protected ref TeamAutoFormation m_AutoFormation;
+    
+    // Release of abandoned vehicle locks (server only)
+    protected ref TeamVehicleLockExpiry m_VehicleLockExpiry;
+    
     // Timer for handling expired invitations
     protected float m_InvitationCleanupTimer;
     
     // Timer for network synchronization
     protected float m_NetworkSyncTimer;
     
-    // Time between cleaning up expired invitations (seconds)
-    protected const float INVITATION_CLEANUP_INTERVAL = 30.0;
+    // Timer for checking the chat filter word list for changes
+    protected float m_ChatFilterReloadTimer;
     
-    // Time between network synchronizations (seconds)
-    protected const float NETWORK_SYNC_INTERVAL = 10.0;
+    // Active settings: loaded at initialization on the authority, received from the server on clients
+    protected TeamManagementSettings m_Settings;
     
     /**
      * @brief Module initialization
@@ -34,6 +40,12 @@ class TeamManagementModule : ScriptModule
     {
         Print("TeamManagementModule - Initializing...");
         
+        // Load server settings before anything reads them; clients keep defaults until the server sends its own
+        if (!GetGame().IsMultiplayer() || GetGame().IsServer())
+            m_Settings = TeamManagementSettings.Load();
+        else
+            m_Settings = TeamManagementSettings.Get();
+        
         // Create and initialize team manager
         m_TeamManager = TeamManager.GetInstance();
         
@@ -44,6 +56,13 @@ class TeamManagementModule : ScriptModule
             Print("TeamManagementModule - Network component initialized");
         }
         
+        // Auto formation places players into teams on the authority only
+        if (!GetGame().IsMultiplayer() || GetGame().IsServer())
+        {
+            m_AutoFormation = new TeamAutoFormation(m_TeamManager);
+            m_VehicleLockExpiry = new TeamVehicleLockExpiry(m_TeamManager);
+        }
+        
         // Set up input manager
         m_InputManager = GetGame().GetInputManager();
         if (m_InputManager)
@@ -76,21 +95,52 @@ class TeamManagementModule : ScriptModule
         
         // Handle invitation cleanup
         m_InvitationCleanupTimer += timeslice;
-        if (m_InvitationCleanupTimer >= INVITATION_CLEANUP_INTERVAL)
+        if (m_InvitationCleanupTimer >= m_Settings.m_InvitationCleanupInterval)
         {
             m_InvitationCleanupTimer = 0;
             CleanupExpiredInvitations();
         }
         
+        // Advance a running auto formation by one update's budget
+        if (m_AutoFormation && m_AutoFormation.IsRunning())
+        {
+            m_AutoFormation.Update();
+        }
+        
+        // Check a slice of the locked vehicles for abandonment
+        if (m_VehicleLockExpiry)
+        {
+            m_VehicleLockExpiry.Update();
+        }
+        
         // Handle network sync for multiplayer
         if (GetGame().IsMultiplayer() && GetGame().IsServer())
         {
+            // Ship this tick's team chat, one packet per team member
+            if (m_NetworkComponent)
+            {
+                m_NetworkComponent.FlushTeamChat();
+                
+                // Write a slice of the moderation chat log
+                TeamChatLog chatLog = m_NetworkComponent.GetChatLog();
+                if (chatLog)
+                    chatLog.Update();
+            }
+            
             m_NetworkSyncTimer += timeslice;
-            if (m_NetworkSyncTimer >= NETWORK_SYNC_INTERVAL)
+            if (m_NetworkSyncTimer >= m_Settings.m_NetworkSyncInterval)
             {
                 m_NetworkSyncTimer = 0;
                 SyncTeamData();
             }
+            
+            // Pick up edits to the chat filter word list; recompiles only when it changed
+            m_ChatFilterReloadTimer += timeslice;
+            if (m_NetworkComponent && m_Settings.m_ChatFilterReloadInterval > 0 && m_ChatFilterReloadTimer >= m_Settings.m_ChatFilterReloadInterval)
+            {
+                m_ChatFilterReloadTimer = 0;
+                m_NetworkComponent.GetChatFilter().Reload();
+            }
         }
     }
     
@@ -148,9 +198,10 @@ class TeamManagementModule : ScriptModule
     {
         // Add any player-specific initialization here
         
-        // For server: sync team data to new player if they're in a team
+        // For server: send the settings, then team data if they're in a team
         if (GetGame().IsServer() && GetGame().IsMultiplayer() && m_NetworkComponent)
         {
+            m_NetworkComponent.SyncSettings(player);
             m_NetworkComponent.SyncTeamData(player);
         }
     }
@@ -171,6 +222,10 @@ class TeamManagementModule : ScriptModule
         
         // Remove player from team when they disconnect
         m_TeamManager.LeaveTeam(player);
+        
+        // Forget the player's chat limits
+        if (m_NetworkComponent)
+            m_NetworkComponent.GetChatRateLimiter().RemoveSender(pc.GetPlayerId());
     }
     
     /**
@@ -181,4 +236,14 @@ class TeamManagementModule : ScriptModule
     {
         return m_TeamManager;
     }
+    
+    /**
+     * @brief Get the auto formation engine
+     * Game modes call Start() on it at round start to place solo players into teams.
+     * @return The auto formation engine, or null on clients
+     */
+    TeamAutoFormation GetAutoFormation()
+    {
+        return m_AutoFormation;
+    }
 }
@@ -97,6 +97,13 @@ class CfgVehicles
         componentNames[] = {};
     };
     
+    // Default vehicle entity; the component replicates the vehicle's lock to joining clients
+    class BaseVehicle;
+    class Vehicle: BaseVehicle
+    {
+        components[] += {"TeamVehicleComponent"};
+    };
+    
     // Respawn component for flagpole
     class TeamRespawnComponent: GenericComponent
     {